@@ -6,15 +6,24 @@ layout (location = 2) in vec4 vColor;
 
 layout (location = 0) out vec4 outColor;
 
+// see CameraData, written once per frame
+layout (std140, set = 0, binding = 0) uniform CameraBuffer
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec4 frustumPlanes[6];
+} camera;
+
 //push constants block
 layout( push_constant ) uniform constants
 {
     vec4 data;
-    mat4 renderMatrix;
+    mat4 modelMatrix;
 } PushConstants;
 
 void main()
 {
-    gl_Position = PushConstants.renderMatrix * vec4(vPosition, 1.0f);
+    gl_Position = camera.viewProjection * PushConstants.modelMatrix * vec4(vPosition, 1.0f);
     outColor = vColor;
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -6,7 +6,7 @@ layout(location = 0) out vec4 outFragColor; // Output color
 layout( push_constant ) uniform constants
 {
     vec4 color;
-    mat4 renderMatrix;
+    mat4 modelMatrix;
 } PushConstants;
 
 void main()
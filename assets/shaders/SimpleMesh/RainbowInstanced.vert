@@ -0,0 +1,48 @@
+#version 450 // GLSL v4.5
+
+#define PI 3.1415926535897932384626433832795
+
+layout (location = 0) in vec3 vPosition;
+
+// per-instance attributes, see InstanceData.h
+layout (location = 1) in mat4 iModelMatrix; // occupies locations 1-4
+layout (location = 5) in vec4 iColor; // unused, the rainbow ignores the material color
+
+// see CameraData, written once per frame
+layout (std140, set = 0, binding = 0) uniform CameraBuffer
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec4 frustumPlanes[6];
+} camera;
+
+layout (location = 0) out vec4 outColor;
+
+void main()
+{
+    const int t = 0;
+
+    // Red Channel
+    float xR = cos(t);
+
+    // Green Channel
+    float xG = cos(t + 2.0 * PI / 3.0);
+
+    // Blue Channel
+    float xB = cos(t + 4.0 * PI / 3.0);
+
+    //const array of colors for the triangle
+    const vec4 colors[3] = vec4[3]
+    (
+        vec4(clamp(xR, 0.0f, 1.0f), clamp(xG, 0.0f, 1.0f), clamp(xB, 0.0f, 1.0f), 1.0f),
+        vec4(clamp(xB, 0.0f, 1.0f), clamp(xR, 0.0f, 1.0f), clamp(xG, 0.0f, 1.0f), 1.0f),
+        vec4(clamp(xG, 0.0f, 1.0f), clamp(xB, 0.0f, 1.0f), clamp(xR, 0.0f, 1.0f), 1.0f)
+    );
+
+    vec4 pos = camera.viewProjection * iModelMatrix * vec4(vPosition, 1.0f);
+    vec4 ndcPos = pos / pos.w;
+
+    gl_Position = ndcPos;
+    outColor = colors[gl_VertexIndex % 3];
+}
@@ -13,7 +13,7 @@
 layout( push_constant ) uniform constants
 {
     vec4 color;
-    mat4 renderMatrix;
+    mat4 modelMatrix;
 } PushConstants;
 
 
@@ -15,16 +15,25 @@ layout (location = 0) in vec3 vPosition;
 layout (location = 0) out vec4 outColor;
 
 //push constants block
+// see CameraData, written once per frame
+layout (std140, set = 0, binding = 0) uniform CameraBuffer
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec4 frustumPlanes[6];
+} camera;
+
 layout( push_constant ) uniform constants
 {
     vec4 color;
-    mat4 renderMatrix;
+    mat4 modelMatrix;
 } PushConstants;
 
 void main()
 {
-    vec4 pos = PushConstants.renderMatrix * vec4(vPosition, 1.0f);
+    vec4 pos = camera.viewProjection * PushConstants.modelMatrix * vec4(vPosition, 1.0f);
     vec4 ndcPos = pos / pos.w;
 
     gl_Position = ndcPos;
-}
\ No newline at end of file
+}
\ No newline at end of file
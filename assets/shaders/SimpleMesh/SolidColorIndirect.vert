@@ -0,0 +1,58 @@
+/// @file    SolidColorIndirect.vert
+/// @author  Matthew Green
+/// @date    2026-10-18 00:11:20
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#version 450 // GLSL v4.5
+
+layout (location = 0) in vec3 vPosition;
+
+// see GPUCullingPass::ObjectData
+struct ObjectData
+{
+    mat4 world;
+    vec4 color;
+    vec4 boundingSphere;
+    uint batchIndex;
+    uint padding0;
+    uint padding1;
+    uint padding2;
+};
+
+layout (std430, set = 0, binding = 0) readonly buffer ObjectBuffer
+{
+    ObjectData objects[];
+};
+
+// written by Cull.comp, gl_InstanceIndex already includes the batch's firstInstance
+layout (std430, set = 0, binding = 2) readonly buffer VisibleBuffer
+{
+    uint visibleObjects[];
+};
+
+// see CameraData, written once per frame
+layout (std140, set = 1, binding = 0) uniform CameraBuffer
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec4 frustumPlanes[6];
+} camera;
+
+layout (location = 0) flat out vec4 outColor;
+
+void main()
+{
+    ObjectData object = objects[visibleObjects[gl_InstanceIndex]];
+
+    vec4 pos = camera.viewProjection * object.world * vec4(vPosition, 1.0f);
+    vec4 ndcPos = pos / pos.w;
+
+    gl_Position = ndcPos;
+    outColor = object.color;
+}
@@ -0,0 +1,20 @@
+/// @file    SolidColorInstanced.frag
+/// @author  Matthew Green
+/// @date    2026-10-17 19:52:40
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#version 450 // GLSL v4.5
+
+layout (location = 0) flat in vec4 inColor; // Instance color
+
+layout(location = 0) out vec4 outFragColor; // Output color
+
+void main()
+{
+    outFragColor = inColor;
+}
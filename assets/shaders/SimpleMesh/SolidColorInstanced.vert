@@ -0,0 +1,37 @@
+/// @file    SolidColorInstanced.vert
+/// @author  Matthew Green
+/// @date    2026-10-17 19:51:07
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#version 450 // GLSL v4.5
+
+layout (location = 0) in vec3 vPosition;
+
+// per-instance attributes, see InstanceData.h
+layout (location = 1) in mat4 iModelMatrix; // occupies locations 1-4
+layout (location = 5) in vec4 iColor;
+
+// see CameraData, written once per frame
+layout (std140, set = 0, binding = 0) uniform CameraBuffer
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec4 frustumPlanes[6];
+} camera;
+
+layout (location = 0) flat out vec4 outColor;
+
+void main()
+{
+    vec4 pos = camera.viewProjection * iModelMatrix * vec4(vPosition, 1.0f);
+    vec4 ndcPos = pos / pos.w;
+
+    gl_Position = ndcPos;
+    outColor = iColor;
+}
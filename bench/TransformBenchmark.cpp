@@ -0,0 +1,347 @@
+/// @file    TransformBenchmark.cpp
+/// @author  Matthew Green
+/// @date    2026-10-18 05:58:37
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "TransformBenchmark.h"
+
+#include "velecs/ECS/Modules/CommonECSModule.h"
+#include "velecs/ECS/Components/Rendering/Transform.h"
+#include "velecs/ECS/Components/Physics/LinearKinematics.h"
+#include "velecs/Core/JobSystem.h"
+#include "velecs/Math/TransformBatch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <random>
+
+namespace velecs {
+
+/// @struct LegacyTransform
+/// @brief The layout Transform had while it held its entity handle and Euler angles, kept to compare against.
+struct LegacyTransform {
+    flecs::entity entity{flecs::entity::null()};
+    Vec3 position{Vec3::ZERO};
+    Vec3 scale{Vec3::ONE};
+    glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+    Vec3 eulerAngles{Vec3::ZERO};
+};
+
+/// @brief Moves entities holding a transform layout by their LinearKinematics, the way the physics module does.
+/// @tparam T The transform layout, with a position field.
+/// @return The average time of a frame, in milliseconds.
+template <typename T>
+static float TimeMovement(const uint32_t entityCount, const uint32_t frameCount)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    const float deltaTime = 1.0f / 60.0f;
+
+    flecs::world ecs;
+    for (uint32_t i = 0; i < entityCount; ++i)
+    {
+        ecs.entity()
+            .set<T>(T())
+            .set<LinearKinematics>({Vec3(1.0f, 0.0f, 0.0f), Vec3::ZERO});
+    }
+
+    flecs::query<T, const LinearKinematics> query = ecs.query<T, const LinearKinematics>();
+
+    const uint32_t frames = std::max(frameCount, 1u);
+    float totalMs = 0.0f;
+    for (uint32_t frame = 0; frame < frames; ++frame)
+    {
+        const Clock::time_point start = Clock::now();
+        query.iter([deltaTime](flecs::iter& it, T* transforms, const LinearKinematics* linears)
+        {
+            for (auto i : it)
+            {
+                transforms[i].position += linears[i].velocity * deltaTime;
+            }
+        });
+        totalMs += std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    }
+
+    return totalMs / frames;
+}
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+std::vector<TransformBenchmark::Result> TransformBenchmark::Run(std::ostream& out, const uint32_t entityCount /* = 100000 */, const uint32_t frameCount /* = 20 */)
+{
+    const uint32_t deepDepth = std::min(64u, std::max(entityCount, 1u));
+
+    VerifyKernels(out);
+    Log(out, MeasureLayout(entityCount, frameCount));
+
+    std::vector<Result> results;
+    results.push_back(Measure("Deep", entityCount, std::max(entityCount / deepDepth, 1u), deepDepth, frameCount));
+    results.push_back(Measure("Wide", entityCount, 1, 2, frameCount));
+
+    for (const Result& result : results)
+    {
+        Log(out, result);
+    }
+
+    const std::vector<Result> scaling = MeasureScaling(out, 200000, frameCount);
+    results.insert(results.end(), scaling.begin(), scaling.end());
+
+    return results;
+}
+
+TransformBenchmark::Result TransformBenchmark::Measure(const std::string& name, const uint32_t entityCount, const uint32_t rootCount, const uint32_t depth, const uint32_t frameCount,
+    JobSystem* const jobSystem /* = nullptr */)
+{
+    using Clock = std::chrono::high_resolution_clock;
+
+    flecs::world ecs;
+    flecs::system propagation = CommonECSModule::InitTransformPropagation(ecs, flecs::entity::null(), jobSystem);
+
+    std::vector<flecs::entity> roots;
+    std::vector<flecs::entity> entities;
+    BuildHierarchy(ecs, entityCount, rootCount, depth, roots, entities);
+
+    Result result;
+    result.name = name;
+    result.entityCount = (uint32_t)entities.size();
+    result.depth = depth;
+    result.threadCount = jobSystem != nullptr ? jobSystem->GetThreadCount() : 1;
+
+    propagation.run(); // the first pass builds every cache
+
+    const uint32_t frames = std::max(frameCount, 1u);
+    for (uint32_t frame = 0; frame < frames; ++frame)
+    {
+        MoveRoots(roots);
+
+        const Clock::time_point start = Clock::now();
+        propagation.run();
+        result.movedMs += std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    }
+
+    for (uint32_t frame = 0; frame < frames; ++frame)
+    {
+        const Clock::time_point start = Clock::now();
+        propagation.run();
+        result.staticMs += std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    }
+
+    //summed so the matrices are not optimized away
+    volatile float sink = 0.0f;
+    for (uint32_t frame = 0; frame < frames; ++frame)
+    {
+        MoveRoots(roots);
+
+        const Clock::time_point start = Clock::now();
+        float sum = 0.0f;
+        for (const flecs::entity& entity : entities)
+        {
+            sum += Transform::GetWorldMatrix(entity)[3][0];
+        }
+        result.onDemandMs += std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+        sink = sink + sum;
+    }
+
+    result.movedMs /= frames;
+    result.staticMs /= frames;
+    result.onDemandMs /= frames;
+
+    return result;
+}
+
+std::vector<TransformBenchmark::Result> TransformBenchmark::MeasureScaling(std::ostream& out, const uint32_t entityCount /* = 200000 */, const uint32_t frameCount /* = 20 */)
+{
+    const uint32_t deepDepth = std::min(64u, std::max(entityCount, 1u));
+
+    std::vector<Result> results;
+    for (const uint32_t threadCount : { 1u, 2u, 4u, 8u })
+    {
+        JobSystem jobSystem(threadCount);
+        results.push_back(Measure("Deep", entityCount, std::max(entityCount / deepDepth, 1u), deepDepth, frameCount, &jobSystem));
+        results.push_back(Measure("Wide", entityCount, 1, 2, frameCount, &jobSystem));
+    }
+
+    for (const Result& result : results)
+    {
+        Log(out, result);
+    }
+
+    return results;
+}
+
+TransformBenchmark::LayoutResult TransformBenchmark::MeasureLayout(const uint32_t entityCount, const uint32_t frameCount)
+{
+    LayoutResult result;
+    result.entityCount = entityCount;
+    result.legacyBytes = sizeof(LegacyTransform);
+    result.compactBytes = sizeof(Transform);
+    result.legacyMs = TimeMovement<LegacyTransform>(entityCount, frameCount);
+    result.compactMs = TimeMovement<Transform>(entityCount, frameCount);
+    return result;
+}
+
+uint32_t TransformBenchmark::VerifyKernels(std::ostream& out, const uint32_t entityCount /* = 10000 */)
+{
+    using Clock = std::chrono::high_resolution_clock;
+
+    flecs::world ecs;
+    CommonECSModule::InitTransformPropagation(ecs, flecs::entity::null());
+
+    //a fixed seed keeps the inputs the same from run to run
+    std::mt19937 random(20231116);
+    std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+    const auto randomTransform = [&]()
+    {
+        Transform transform(Vec3(distribution(random), distribution(random), distribution(random)), Vec3::ZERO,
+            Vec3(distribution(random), distribution(random), distribution(random)));
+        transform.SetRotation(glm::quat(distribution(random), distribution(random), distribution(random), distribution(random)));
+        return transform;
+    };
+
+    flecs::entity parent = ecs.entity();
+    parent.set<Transform>(randomTransform());
+
+    std::vector<glm::vec3> positions(entityCount);
+    std::vector<glm::quat> rotations(entityCount);
+    std::vector<glm::vec3> scales(entityCount);
+    std::vector<glm::mat4> expected(entityCount);
+    std::vector<glm::mat4> expectedNoScale(entityCount);
+    for (uint32_t i = 0; i < entityCount; ++i)
+    {
+        flecs::entity child = ecs.entity().child_of(parent);
+        child.set<Transform>(randomTransform());
+
+        const Transform* const transform = child.get<Transform>();
+        positions[i] = glm::vec3(transform->position);
+        rotations[i] = transform->GetRotation();
+        scales[i] = glm::vec3(transform->scale);
+        expected[i] = Transform::GetWorldMatrix(child);
+        expectedNoScale[i] = Transform::GetWorldMatrixNoScale(child);
+    }
+
+    const glm::mat4 parentMatrix = Transform::GetWorldMatrix(parent);
+    const glm::mat4 parentMatrixNoScale = Transform::GetWorldMatrixNoScale(parent);
+
+    std::vector<glm::mat4> locals(entityCount);
+    std::vector<glm::mat4> matrices(entityCount);
+    std::vector<glm::mat4> matricesNoScale(entityCount);
+
+    const TransformBatch::Kernel activeKernel = TransformBatch::GetKernel();
+    uint32_t totalMismatches = 0;
+    for (const TransformBatch::Kernel kernel : { TransformBatch::Kernel::Scalar, TransformBatch::Kernel::SSE, TransformBatch::Kernel::AVX })
+    {
+        if (!TransformBatch::IsSupported(kernel))
+        {
+            out << "[INFO] [TransformBenchmark] " << TransformBatch::GetKernelName(kernel) << " kernel: not supported." << std::endl;
+            continue;
+        }
+
+        TransformBatch::SetKernel(kernel);
+
+        const Clock::time_point start = Clock::now();
+        TransformBatch::Compose(entityCount, positions.data(), rotations.data(), scales.data(),
+            parentMatrix, parentMatrixNoScale, locals.data(), matrices.data(), matricesNoScale.data());
+        const float ms = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+        uint32_t mismatches = 0;
+        for (uint32_t i = 0; i < entityCount; ++i)
+        {
+            if (std::memcmp(&matrices[i], &expected[i], sizeof(glm::mat4)) != 0 ||
+                std::memcmp(&matricesNoScale[i], &expectedNoScale[i], sizeof(glm::mat4)) != 0)
+            {
+                ++mismatches;
+            }
+        }
+        totalMismatches += mismatches;
+
+        out << "[" << (mismatches == 0 ? "INFO" : "ERROR") << "] [TransformBenchmark] " << TransformBatch::GetKernelName(kernel) << " kernel: "
+            << mismatches << " of " << entityCount << " matrices differ from GetWorldMatrix, " << ms << " ms." << std::endl;
+    }
+
+    TransformBatch::SetKernel(activeKernel);
+
+    return totalMismatches;
+}
+
+void TransformBenchmark::Log(std::ostream& out, const Result& result)
+{
+    out << "[INFO] [TransformBenchmark] " << result.name << " (" << result.entityCount << " entities, depth " << result.depth << ", " << result.threadCount << " threads): "
+        << "moved " << result.movedMs << " ms, static " << result.staticMs << " ms, on demand " << result.onDemandMs << " ms per frame." << std::endl;
+}
+
+void TransformBenchmark::Log(std::ostream& out, const LayoutResult& result)
+{
+    out << "[INFO] [TransformBenchmark] Layout (" << result.entityCount << " entities): "
+        << "former " << result.legacyBytes << " bytes, " << result.legacyBytes * result.entityCount / 1024 << " KiB, moved in " << result.legacyMs << " ms; "
+        << "compact " << result.compactBytes << " bytes, " << result.compactBytes * result.entityCount / 1024 << " KiB, moved in " << result.compactMs << " ms per frame." << std::endl;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void TransformBenchmark::BuildHierarchy(flecs::world& ecs, const uint32_t entityCount, const uint32_t rootCount, const uint32_t depth,
+    std::vector<flecs::entity>& roots, std::vector<flecs::entity>& entities)
+{
+    const uint32_t levels = std::max(depth, 1u);
+    const uint32_t clampedRootCount = std::max(std::min(rootCount, entityCount), 1u);
+
+    entities.clear();
+    entities.reserve(entityCount);
+
+    for (uint32_t i = 0; i < clampedRootCount; ++i)
+    {
+        flecs::entity entity = ecs.entity();
+        entity.set<Transform>(Transform(Vec3(1.0f, 0.0f, 0.0f), Vec3(0.0f, 15.0f, 0.0f)));
+        entities.push_back(entity);
+    }
+    roots = entities;
+
+    size_t levelStart = 0;
+    size_t levelSize = entities.size();
+    for (uint32_t level = 1; level < levels; ++level)
+    {
+        //the remaining entities are spread over the remaining levels
+        const uint32_t remaining = entityCount - (uint32_t)entities.size();
+        const uint32_t count = level + 1 == levels ? remaining : remaining / (levels - level);
+        if (count == 0)
+        {
+            break;
+        }
+
+        const size_t nextLevelStart = entities.size();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const flecs::entity parent = entities[levelStart + i % levelSize];
+            flecs::entity entity = ecs.entity().child_of(parent);
+            entity.set<Transform>(Transform(Vec3(0.0f, 1.0f, 0.0f), Vec3(5.0f, 0.0f, 0.0f), Vec3(0.99f, 0.99f, 0.99f)));
+            entities.push_back(entity);
+        }
+
+        levelStart = nextLevelStart;
+        levelSize = count;
+    }
+}
+
+void TransformBenchmark::MoveRoots(const std::vector<flecs::entity>& roots)
+{
+    for (const flecs::entity& root : roots)
+    {
+        root.get_mut<Transform>()->position.x += 0.01f;
+    }
+}
+
+} // namespace velecs
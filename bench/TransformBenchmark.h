@@ -0,0 +1,150 @@
+/// @file    TransformBenchmark.h
+/// @author  Matthew Green
+/// @date    2026-10-18 05:58:37
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <flecs.h>
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace velecs {
+
+class JobSystem;
+
+/// @class TransformBenchmark
+/// @brief Times the transform propagation pass against on demand world matrices on synthetic hierarchies,
+/// the compact Transform layout against the one holding the entity handle and the Euler angles, and the
+/// propagation pass over several thread counts.
+///
+/// Every hierarchy is built in a world of its own holding nothing but transforms, so the timings
+/// only cover the transforms. The game's world is left untouched and the benchmark can run at any time.
+class TransformBenchmark {
+public:
+    // Enums
+
+    // Public Fields
+
+    /// @struct Result
+    /// @brief Average times of one hierarchy, in milliseconds per frame.
+    struct Result {
+        std::string name; /// @brief Name of the hierarchy.
+        uint32_t entityCount{0}; /// @brief Number of entities, roots included.
+        uint32_t depth{0}; /// @brief Number of levels, 1 for roots only.
+        uint32_t threadCount{1}; /// @brief Number of threads the propagation pass ran on.
+        float movedMs{0.0f}; /// @brief Propagation pass after every root moved, so every cache is rebuilt.
+        float staticMs{0.0f}; /// @brief Propagation pass with nothing moved, so every cache is only validated.
+        float onDemandMs{0.0f}; /// @brief GetWorldMatrix on every entity after every root moved, without the pass.
+    };
+
+    /// @struct LayoutResult
+    /// @brief Memory and iteration time of the former and the compact Transform layouts.
+    struct LayoutResult {
+        uint32_t entityCount{0}; /// @brief Number of entities moved.
+        size_t legacyBytes{0}; /// @brief Size of the former layout, entity handle and Euler angles included.
+        size_t compactBytes{0}; /// @brief Size of Transform.
+        float legacyMs{0.0f}; /// @brief Moving every entity by its LinearKinematics with the former layout, per frame.
+        float compactMs{0.0f}; /// @brief Moving every entity by its LinearKinematics with Transform, per frame.
+    };
+
+    // Deleted constructors and assignment operators
+    TransformBenchmark() = delete;
+    ~TransformBenchmark() = delete;
+    TransformBenchmark(const TransformBenchmark&) = delete;
+    TransformBenchmark(TransformBenchmark&&) = delete;
+    TransformBenchmark& operator=(const TransformBenchmark&) = delete;
+    TransformBenchmark& operator=(TransformBenchmark&&) = delete;
+
+    // Public Methods
+
+    /// @brief Checks the TransformBatch kernels, compares the Transform layouts, measures a deep and a wide hierarchy,
+    /// then how the propagation pass scales over threads, and logs the results.
+    /// @param[in,out] out The stream to log to.
+    /// @param[in] entityCount The number of entities of every hierarchy.
+    /// @param[in] frameCount The number of frames every time is averaged over.
+    /// @return The result of every hierarchy, followed by those of every thread count.
+    static std::vector<Result> Run(std::ostream& out, const uint32_t entityCount = 100000, const uint32_t frameCount = 20);
+
+    /// @brief Measures one hierarchy.
+    ///
+    /// The roots are the first level. Every following level spreads the remaining entities evenly
+    /// and parents them round-robin to the entities of the level above.
+    /// @param[in] name The name of the hierarchy.
+    /// @param[in] entityCount The number of entities, roots included.
+    /// @param[in] rootCount The number of roots.
+    /// @param[in] depth The number of levels.
+    /// @param[in] frameCount The number of frames every time is averaged over.
+    /// @param[in] jobSystem The threads the propagation pass runs on, nullptr for the calling thread only.
+    /// @return The average times.
+    static Result Measure(const std::string& name, const uint32_t entityCount, const uint32_t rootCount, const uint32_t depth, const uint32_t frameCount,
+        JobSystem* const jobSystem = nullptr);
+
+    /// @brief Measures a deep and a wide hierarchy with the propagation pass running on 1, 2, 4 and 8 threads.
+    /// @param[in,out] out The stream to log to.
+    /// @param[in] entityCount The number of entities of every hierarchy.
+    /// @param[in] frameCount The number of frames every time is averaged over.
+    /// @return The result of every hierarchy at every thread count.
+    static std::vector<Result> MeasureScaling(std::ostream& out, const uint32_t entityCount = 200000, const uint32_t frameCount = 20);
+
+    /// @brief Compares the memory and the iteration time of the compact Transform layout to the former one.
+    ///
+    /// Both are moved the way the physics module does, in worlds of their own holding the same entities.
+    /// @param[in] entityCount The number of entities.
+    /// @param[in] frameCount The number of frames the times are averaged over.
+    /// @return The sizes and average times.
+    static LayoutResult MeasureLayout(const uint32_t entityCount, const uint32_t frameCount);
+
+    /// @brief Checks every supported TransformBatch kernel against Transform::GetWorldMatrix and times it.
+    ///
+    /// Children with random transforms under a common parent are composed by every kernel in turn. Every
+    /// matrix has to be identical, bit for bit, to the one GetWorldMatrix or GetWorldMatrixNoScale returns.
+    /// @param[in,out] out The stream to log to.
+    /// @param[in] entityCount The number of children.
+    /// @return The number of matrices differing from GetWorldMatrix, over every kernel.
+    static uint32_t VerifyKernels(std::ostream& out, const uint32_t entityCount = 10000);
+
+    /// @brief Logs a result on one line.
+    /// @param[in,out] out The stream to log to.
+    /// @param[in] result The result to log.
+    static void Log(std::ostream& out, const Result& result);
+
+    /// @brief Logs a layout comparison on one line.
+    /// @param[in,out] out The stream to log to.
+    /// @param[in] result The result to log.
+    static void Log(std::ostream& out, const LayoutResult& result);
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+
+    /// @brief Creates the entities of a hierarchy.
+    /// @param[in] ecs The world to create them in.
+    /// @param[in] entityCount The number of entities, roots included.
+    /// @param[in] rootCount The number of roots.
+    /// @param[in] depth The number of levels.
+    /// @param[out] roots The roots.
+    /// @param[out] entities Every entity, roots included, parents before children.
+    static void BuildHierarchy(flecs::world& ecs, const uint32_t entityCount, const uint32_t rootCount, const uint32_t depth,
+        std::vector<flecs::entity>& roots, std::vector<flecs::entity>& entities);
+
+    /// @brief Moves every root, leaving every cache below them stale.
+    /// @param[in] roots The roots to move.
+    static void MoveRoots(const std::vector<flecs::entity>& roots);
+};
+
+} // namespace velecs
@@ -0,0 +1,35 @@
+/// @file    main.cpp
+/// @author  Matthew Green
+/// @date    2026-10-18 07:24:12
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "TransformBenchmark.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+/// @brief Runs the transform benchmark and logs its results.
+///
+/// Usage: velecs-bench [entityCount] [frameCount]
+///        velecs-bench --verify, only checks the TransformBatch kernels and fails if any matrix differs.
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && std::strcmp(argv[1], "--verify") == 0)
+    {
+        return velecs::TransformBenchmark::VerifyKernels(std::cout) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    const uint32_t entityCount = argc > 1 ? (uint32_t)std::strtoul(argv[1], nullptr, 10) : 100000;
+    const uint32_t frameCount = argc > 2 ? (uint32_t)std::strtoul(argv[2], nullptr, 10) : 20;
+
+    velecs::TransformBenchmark::Run(std::cout, entityCount, frameCount);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,91 @@
+/// @file    JobSystem.h
+/// @author  Matthew Green
+/// @date    2026-10-17 23:41:12
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace velecs {
+
+/// @class JobSystem
+/// @brief Fixed pool of worker threads running fork-join parallel loops.
+///
+/// The calling thread takes part in every ParallelFor, so a JobSystem created with a
+/// single thread runs everything inline without any synchronization.
+class JobSystem {
+public:
+    // Enums
+
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Starts the worker threads.
+    /// @param[in] threadCount The number of threads running jobs, the calling thread included. 0 uses every hardware thread.
+    explicit JobSystem(const uint32_t threadCount = 0);
+
+    /// @brief Joins the worker threads.
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Public Methods
+
+    /// @brief Gets the number of threads running jobs, the calling thread included.
+    /// @return The thread count, at least 1.
+    inline uint32_t GetThreadCount() const { return (uint32_t)workers.size() + 1; }
+
+    /// @brief Runs job once for every index in [0, count) and blocks until they all returned.
+    /// @param[in] count The number of jobs.
+    /// @param[in] job The function to run, called concurrently from several threads.
+    /// @throws The first exception thrown by a job, once every job has finished.
+    void ParallelFor(const uint32_t count, const std::function<void(uint32_t index)>& job);
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wakeCondition; /// @brief Signaled when a new loop starts or the system stops.
+    std::condition_variable doneCondition; /// @brief Signaled when the last worker leaves a loop.
+
+    const std::function<void(uint32_t)>* job{nullptr};
+    uint32_t jobCount{0};
+    std::atomic<uint32_t> nextJob{0};
+    uint64_t generation{0}; /// @brief Incremented by every ParallelFor, workers wake up when it changes.
+    uint32_t activeWorkers{0}; /// @brief Workers currently taking jobs from the running loop.
+    bool stopping{false};
+
+    std::exception_ptr exception; /// @brief First exception thrown by a job of the running loop.
+
+    // Private Methods
+
+    /// @brief Main loop of a worker thread.
+    void WorkerLoop();
+
+    /// @brief Takes and runs jobs of the running loop until there are none left.
+    void RunJobs();
+};
+
+} // namespace velecs
@@ -27,6 +27,7 @@ public:
     flecs::entity InputUpdate;
 	flecs::entity Update;
 	flecs::entity Collisions;
+	flecs::entity TransformPropagation;
 	flecs::entity PreDraw;
 	flecs::entity Draw;
 	flecs::entity PostDraw;
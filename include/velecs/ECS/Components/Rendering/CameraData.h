@@ -0,0 +1,70 @@
+/// @file    CameraData.h
+/// @author  Matthew Green
+/// @date    2026-10-18 01:20:44
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Math/Frustum.h"
+
+#include <glm/mat4x4.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace velecs {
+
+/// @struct CameraData
+/// @brief Singleton component holding the main camera's matrices, computed once per frame in PreDraw.
+///
+/// The same data is uploaded to a per-frame uniform buffer, the shaders multiply viewProjection
+/// by the model matrix themselves. The matrices and frustum planes match CameraBuffer in the shaders (std140).
+struct CameraData {
+    // Enums
+
+    // Public Fields
+
+    glm::mat4 view{1.0f}; /// @brief World to view space matrix.
+    glm::mat4 projection{1.0f}; /// @brief View to clip space matrix.
+    glm::mat4 viewProjection{1.0f}; /// @brief projection multiplied by view.
+    Frustum frustum; /// @brief World space planes of viewProjection.
+
+    float farPlane{1.0f}; /// @brief Distance to the far plane, used to normalize the depth of sorted draws.
+    uint32_t perspective{0}; /// @brief 1 if the main camera is a PerspectiveCamera.
+    uint32_t _padding[2]{};
+
+    glm::mat4 previousViewProjection{1.0f}; /// @brief viewProjection of the previous frame, the one its depth was rendered with.
+
+    // Public Methods
+
+    /// @brief Gets the distance of a world space point along the view direction.
+    /// @param[in] point The point.
+    /// @return The clip space w of the point, which is its view depth for a perspective camera.
+    inline float GetViewDepth(const glm::vec4& point) const
+    {
+        return viewProjection[0][3] * point.x + viewProjection[1][3] * point.y + viewProjection[2][3] * point.z + viewProjection[3][3] * point.w;
+    }
+
+    /// @brief Gets how many pixels a world space unit covers on screen at a view depth.
+    /// @param[in] viewDepth The distance along the view direction, as returned by GetViewDepth.
+    /// @param[in] viewportHeight The height of the viewport in pixels.
+    /// @return The vertical pixel size of a unit, the largest float for depths at or behind the camera.
+    inline float GetPixelsPerUnit(const float viewDepth, const float viewportHeight) const
+    {
+        //projection[1][1] maps a unit at depth 1 (or any depth for an orthographic camera) to half the viewport
+        const float pixelsAtUnitDepth = std::abs(projection[1][1]) * 0.5f * viewportHeight;
+        if (perspective == 0)
+        {
+            return pixelsAtUnitDepth;
+        }
+        return viewDepth > 0.0f ? pixelsAtUnitDepth / viewDepth : std::numeric_limits<float>::max();
+    }
+};
+
+} // namespace velecs
@@ -34,6 +34,8 @@ struct Material {
     Color32 color{Color32::MAGENTA}; /// @brief The color of the material.
     VkPipeline* pipeline{nullptr}; /// @brief The Vulkan pipeline associated with this material.
     VkPipelineLayout* pipelineLayout{nullptr}; /// @brief The Vulkan pipeline layout associated with this material.
+    VkPipeline* instancedPipeline{nullptr}; /// @brief Optional instanced variant of the pipeline. Entities are batched into instanced draws when set.
+    VkPipeline* indirectPipeline{nullptr}; /// @brief Optional GPU-driven variant of the pipeline, created with the GPUCullingPass layout. Entities are culled and drawn on the GPU when set.
 
     // Constructors and Destructors
 
@@ -51,6 +53,8 @@ struct Material {
     /// @param[in] pipeline The Vulkan pipeline for the material.
     /// @param[in] pipelineLayout The Vulkan pipeline layout for the material.
     /// @param[in] color The color of the material.
+    /// @param[in] instancedPipeline The optional instanced variant of the pipeline, sharing the same pipeline layout.
+    /// @param[in] indirectPipeline The optional GPU-driven variant of the pipeline.
     /// @return const Material* const A pointer to the newly created Material component.
     static const Material* const Create
     (
@@ -58,7 +62,9 @@ struct Material {
         const std::string& path,
         VkPipeline* const pipeline,
         VkPipelineLayout* const pipelineLayout,
-        const Color32 color = Color32::MAGENTA
+        const Color32 color = Color32::MAGENTA,
+        VkPipeline* const instancedPipeline = nullptr,
+        VkPipeline* const indirectPipeline = nullptr
     );
 
     /// @brief Finds a Material component based on the search path.
@@ -135,6 +141,18 @@ struct Material {
             *pipeline = VK_NULL_HANDLE;
         }
 
+        if (instancedPipeline != VK_NULL_HANDLE)
+        {
+            vkDestroyPipeline(device, *instancedPipeline, nullptr);
+            *instancedPipeline = VK_NULL_HANDLE;
+        }
+
+        if (indirectPipeline != VK_NULL_HANDLE)
+        {
+            vkDestroyPipeline(device, *indirectPipeline, nullptr);
+            *indirectPipeline = VK_NULL_HANDLE;
+        }
+
         if (pipelineLayout != VK_NULL_HANDLE)
         {
             vkDestroyPipelineLayout(device, *pipelineLayout, nullptr);
@@ -0,0 +1,57 @@
+/// @file    RenderSettings.h
+/// @author  Matthew Green
+/// @date    2026-10-17 19:05:12
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct RenderSettings
+/// @brief Singleton component holding the construction-time options of the RenderingECSModule.
+///
+/// Set this singleton on the flecs::world before importing the RenderingECSModule to override
+/// the defaults. The module reads it once during construction; changing it afterwards has no effect.
+struct RenderSettings {
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 4; /// @brief Upper bound for framesInFlight.
+
+    uint32_t framesInFlight{2}; /// @brief Number of frames the CPU may record ahead of the GPU.
+
+    uint32_t meshArenaVertexCapacity{1u << 20}; /// @brief Number of vertices the mesh arena can hold.
+    uint32_t meshArenaIndexCapacity{1u << 22}; /// @brief Number of indices the mesh arena can hold.
+    uint32_t stagingRingSize{32u << 20}; /// @brief Size in bytes of the staging ring mesh uploads go through.
+    bool quantizePositions{false}; /// @brief Uploads SimpleMesh positions as 16-bit normalized integers, 8 bytes per vertex instead of 12.
+
+    VkPresentModeKHR presentMode{VK_PRESENT_MODE_FIFO_KHR}; /// @brief Requested present mode, falls back to the closest mode the surface supports.
+    uint32_t swapchainImageCount{0}; /// @brief Minimum number of swapchain images. 0 lets the driver pick, or 2 in low latency mode.
+    bool lowLatency{false}; /// @brief Keeps no frame queued on the GPU and samples input as late as the present interval allows.
+
+    uint32_t recordingThreads{0}; /// @brief Most threads of the engine's job system recording the render queue into secondary command buffers. 0 uses all of them.
+
+    bool headless{false}; /// @brief Renders into an offscreen image without a window or presentation, as fast as possible.
+    uint32_t headlessWidth{1700}; /// @brief Width of the offscreen image in headless mode.
+    uint32_t headlessHeight{900}; /// @brief Height of the offscreen image in headless mode.
+    uint32_t headlessFrameCount{0}; /// @brief Frames rendered before quitting in headless mode. 0 runs until the game quits.
+
+    bool gpuProfiling{true}; /// @brief Measures the GPU time of every pass with timestamp queries and shows it in an overlay.
+
+    bool gpuDrivenRendering{true}; /// @brief Culls and draws materials with an indirect pipeline on the GPU. Falls back to CPU culling when false.
+    float lodThresholdPixels{1.0f}; /// @brief Largest simplification error, in pixels, a mesh level of detail may show. 0 always draws full detail.
+
+    bool occlusionCulling{false}; /// @brief Also culls GPU-driven objects hidden behind the previous frame's depth. Requires gpuDrivenRendering.
+};
+
+} // namespace velecs
@@ -11,8 +11,15 @@
 #pragma once
 
 #include "velecs/Rendering/SimpleVertex.h"
-#include "velecs/Memory/AllocatedBuffer.h"
+#include "velecs/Rendering/MeshRange.h"
+#include "velecs/Rendering/MeshLOD.h"
+#include "velecs/Math/Bounds.h"
 
+#include <glm/vec4.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <utility>
 #include <vector>
 
 namespace velecs {
@@ -28,20 +35,41 @@ public:
     // Enums
 
     // Public Fields
+
+    static constexpr uint32_t MAX_LODS = 5; /// @brief Number of levels GenerateLODs creates at most, the full detail one included.
+    static constexpr float LOD_REDUCTION = 0.5f; /// @brief Fraction of the previous level's triangles every level aims for.
+    static constexpr uint32_t MIN_LOD_TRIANGLES = 16; /// @brief Levels below this triangle count are not generated.
         
     std::vector<SimpleVertex> _vertices; /// @brief Vertex data of the mesh.
-    std::vector<uint32_t> _indices; /// @brief Indices for drawing the mesh.
-    AllocatedBuffer _vertexBuffer; /// @brief Allocated buffer for vertex data.
-    AllocatedBuffer _indexBuffer; /// @brief Allocated buffer for index data.
+    std::vector<uint32_t> _indices; /// @brief Indices for drawing the mesh, every level of detail one after the other.
+    std::vector<MeshLOD> _lods; /// @brief Levels of detail in _indices, from full detail to coarsest. Empty if _indices is a single level.
+    MeshRange _range; /// @brief Location of the uploaded vertex and index data in the MeshArena, owned by this mesh and released when it is removed or overwritten.
+    uint64_t _uploadTicket{0}; /// @brief Ticket of the upload writing _range. The mesh can be drawn once it has retired.
+    std::weak_ptr<std::vector<std::pair<MeshRange, uint64_t>>> _releasedRanges; /// @brief Renderer list _range and _uploadTicket are handed to on release, set on upload. Expires with the renderer.
+    glm::vec4 _positionDequantization{0.0f, 0.0f, 0.0f, 1.0f}; /// @brief Offset (xyz) and scale (w) of the uploaded positions if they were quantized, see QuantizedSimpleVertex.
+    AABB _bounds; /// @brief Local space box enclosing every vertex.
+    BoundingSphere _boundingSphere; /// @brief Local space sphere enclosing every vertex.
 
     // Constructors and Destructors
 
     /// @brief Default constructor.
     SimpleMesh() = default;
 
+    /// @brief Copy constructor. The copy is not uploaded, only the original owns its arena range.
+    SimpleMesh(const SimpleMesh& other);
+
+    /// @brief Move constructor. The arena range moves along, the moved-from mesh is no longer uploaded.
+    SimpleMesh(SimpleMesh&& other) noexcept;
+
     /// @brief Default deconstructor.
     ~SimpleMesh() = default;
 
+    /// @brief Copy assignment operator. Releases the arena range held so far, the copy is not uploaded.
+    SimpleMesh& operator=(const SimpleMesh& other);
+
+    /// @brief Move assignment operator. Releases the arena range held so far and takes over the one of other.
+    SimpleMesh& operator=(SimpleMesh&& other) noexcept;
+
     // Public Methods
 
     /// @brief Creates and returns a predefined equilateral triangle mesh.
@@ -68,6 +96,33 @@ public:
     /// @return True if loading succeeds, false otherwise.
     static bool TryLoad(const std::string& filePath, SimpleMesh*& mesh);
 
+    /// @brief Hands the arena range to the renderer, which frees it once no frame in flight draws it, and resets it.
+    void ReleaseRange();
+
+    /// @brief Recomputes _bounds and _boundingSphere from the vertices.
+    void RecalculateBounds();
+
+    /// @brief Simplifies the full detail triangles into a chain of coarser levels appended to _indices.
+    ///
+    /// Replaces the levels generated before. Must be called before the mesh is uploaded.
+    /// @param[in] maxLODs The number of levels to create at most, the full detail one included.
+    void GenerateLODs(const uint32_t maxLODs = MAX_LODS);
+
+    /// @brief Gets the number of levels of detail.
+    /// @return At least 1, the full detail level.
+    inline uint32_t GetLODCount() const { return _lods.empty() ? 1 : (uint32_t)_lods.size(); }
+
+    /// @brief Gets the location of a level of detail in the MeshArena.
+    /// @param[in] lod The level, below GetLODCount.
+    /// @return The range to pass to vkCmdDrawIndexed.
+    MeshRange GetLODRange(const uint32_t lod) const;
+
+    /// @brief Picks the coarsest level whose error stays below a threshold once projected.
+    /// @param[in] pixelsPerUnit The number of pixels a local space unit of the mesh covers on screen.
+    /// @param[in] thresholdPixels The largest error, in pixels, a level may show.
+    /// @return The level to draw.
+    uint32_t SelectLOD(const float pixelsPerUnit, const float thresholdPixels) const;
+
 protected:
     // Protected Fields
 
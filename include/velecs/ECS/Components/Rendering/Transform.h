@@ -15,10 +15,12 @@
 #include "velecs/ECS/Components/Rendering/MainCamera.h"
 #include "velecs/ECS/Components/Rendering/OrthoCamera.h"
 #include "velecs/ECS/Components/Rendering/PerspectiveCamera.h"
+#include "velecs/ECS/Components/Rendering/WorldTransform.h"
 
 #include <flecs.h>
 
 #include <glm/mat4x4.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 namespace velecs {
 
@@ -29,15 +31,18 @@ namespace velecs {
 /// and scale of entities in a 3D environment. It provides methods to calculate absolute
 /// positions, retrieve associated camera components, and compute transformation matrices
 /// for rendering.
+///
+/// Only the local position, rotation and scale are stored, so the loops iterating the component fit
+/// more of them per cache line. The rotation is kept as a normalized quaternion and the Euler angles
+/// are derived from it. Everything depending on the hierarchy or the world takes the entity, as
+/// systems get it from their iterator, and the world matrices are cached in WorldTransform.
 struct Transform {    
 public:
     // Enums
 
     // Public Fields
 
-    flecs::entity entity{flecs::entity::null()}; /// @brief The entity this transform component is associated with.
     Vec3 position{Vec3::ZERO}; /// @brief The local position of the entity.
-    Vec3 rotation{Vec3::ZERO}; /// @brief The local rotation of the entity in Euler angles (degrees).
     Vec3 scale{Vec3::ONE}; /// @brief The local scale of the entity.
 
     // Constructors and Destructors
@@ -46,75 +51,161 @@ public:
     Transform() = default;
 
     /// @brief Constructor to initialize the Transform component with specific values.
-    /// @param[in] entity The entity this transform is associated with.
     /// @param[in] position The local position of the entity.
     /// @param[in] rotation The local rotation of the entity in Euler angles.
     /// @param[in] scale The local scale of the entity.
-    Transform(flecs::entity entity, Vec3 position = Vec3::ZERO, Vec3 rotation = Vec3::ZERO, Vec3 scale = Vec3::ONE);
+    Transform(Vec3 position, Vec3 rotation = Vec3::ZERO, Vec3 scale = Vec3::ONE);
 
     /// @brief Default deconstructor.
     ~Transform() = default;
 
     // Public Methods
 
-    /// @brief Gets the parent entity of this transform's entity.
-    /// @throws std::runtime_error if the entity handle is not set.
+    /// @brief Gets the parent entity of an entity.
+    /// @param[in] entity The entity.
+    /// @throws std::runtime_error if the entity is null.
     /// @return The parent entity.
-    flecs::entity GetParent() const;
+    static flecs::entity GetParent(const flecs::entity entity);
 
-    /// @brief Attempts to get the parent entity of this transform's entity.
+    /// @brief Attempts to get the parent entity of an entity.
+    /// @param[in] entity The entity.
     /// @param[out] parentEntity The parent entity, if found.
     /// @return True if a parent entity exists, false otherwise.
-    bool TryGetParent(flecs::entity& parentEntity) const;
+    static bool TryGetParent(const flecs::entity entity, flecs::entity& parentEntity);
 
-    /// @brief Gets the Transform component of the parent entity.
+    /// @brief Gets the Transform component of the parent of an entity.
+    /// @param[in] entity The entity.
     /// @throws std::runtime_error if the parent entity does not exist.
     /// @return A pointer to the parent's Transform component.
-    const Transform* const GetParentTransform() const;
+    static const Transform* const GetParentTransform(const flecs::entity entity);
 
-    /// @brief Attempts to get the Transform component of the parent entity.
+    /// @brief Attempts to get the Transform component of the parent of an entity.
+    /// @param[in] entity The entity.
     /// @param[out] transform The Transform component of the parent entity, if found.
     /// @return True if the parent's Transform component is found, false otherwise.
-    bool TryGetParentTransform(const Transform*& transform) const;
+    static bool TryGetParentTransform(const flecs::entity entity, const Transform*& transform);
 
     /// @brief Retrieves the entity associated with the main camera in the scene.
+    /// @param[in] ecs The world holding the MainCamera component.
     /// @throws std::runtime_error if the MainCamera component is missing or uninitialized.
     /// @return The main camera entity.
-    flecs::entity GetCameraEntity() const;
+    static flecs::entity GetCameraEntity(const flecs::world& ecs);
 
     /// @brief Retrieves the Transform component of the main camera entity.
+    /// @param[in] ecs The world holding the MainCamera component.
     /// @return A pointer to the Transform component of the main camera entity.
-    const Transform* const GetCameraTransform() const;
+    static const Transform* const GetCameraTransform(const flecs::world& ecs);
 
     /// @brief Retrieves a mutable reference to the Transform component of the main camera entity.
+    /// @param[in] ecs The world holding the MainCamera component.
     /// @return A mutable pointer to the Transform component of the main camera entity.
-    Transform* const GetCameraTransform();
+    static Transform* const GetCameraTransform(flecs::world& ecs);
 
-    /// @brief Calculates the absolute position of the entity in the world.
-    /// @return The absolute world position.
-    const Vec3 GetAbsPosition() const;
+    /// @brief Gets the local rotation as Euler angles.
+    /// @return The angles decomposed from the quaternion, in degrees. See GLMUtility::QuatToEuler for their range.
+    Vec3 GetEulerAngles() const;
 
-    Vec3 GetForwardVector() const;
+    /// @brief Sets the local rotation from Euler angles, applied about X, then Y, then Z in local space.
+    /// @param[in] degrees The rotation about each axis, in degrees.
+    void SetEulerAngles(const Vec3 degrees);
+
+    /// @brief Gets the local rotation.
+    /// @return The normalized quaternion.
+    inline const glm::quat& GetRotation() const { return rotation; }
+
+    /// @brief Sets the local rotation.
+    /// @param[in] newRotation The rotation, normalized before it is stored.
+    void SetRotation(const glm::quat& newRotation);
 
-    glm::mat4 GetWorldMatrix() const;
+    /// @brief Turns the local rotation part of the way towards a target along the shorter arc.
+    /// @param[in] target The rotation to turn towards.
+    /// @param[in] t The fraction of the way to turn, 1 reaches the target.
+    void SlerpRotation(const glm::quat& target, const float t);
 
-    glm::mat4 GetWorldMatrixNoScale() const;
+    /// @brief Calculates the absolute position of an entity in the world.
+    /// @param[in] entity The entity, holding a Transform.
+    /// @return The absolute world position.
+    static const Vec3 GetAbsPosition(const flecs::entity entity);
 
-    glm::mat4 GetViewMatrix() const;
+    /// @brief Gets the direction the local -Z axis points to in the space of the parent, the way cameras look.
+    /// @return The unit forward vector.
+    Vec3 GetForwardVector() const;
 
-    /// @brief Calculates the render matrix for perspective camera rendering.
-    /// @param[in] cameraTransform The Transform component of the camera.
+    /// @brief Gets the local to world matrix of an entity, recomputed only if it or an ancestor changed since it was cached.
+    /// @param[in] entity The entity, holding a Transform.
+    /// @return The world matrix.
+    static glm::mat4 GetWorldMatrix(const flecs::entity entity);
+
+    /// @brief Gets the local to world matrix of an entity ignoring scale, recomputed only if it or an ancestor changed since it was cached.
+    /// @param[in] entity The entity, holding a Transform.
+    /// @return The world matrix without scale.
+    static glm::mat4 GetWorldMatrixNoScale(const flecs::entity entity);
+
+    /// @brief Gets the world to local matrix of an entity ignoring scale, used as the view matrix of cameras.
+    /// @param[in] entity The entity, holding a Transform.
+    /// @return The inverse of the world matrix without scale.
+    static glm::mat4 GetViewMatrix(const flecs::entity entity);
+
+    /// @brief Gets the cached world matrices of an entity, refreshing them and those of any stale ancestor first.
+    ///
+    /// Systems running after the TransformPropagation stage can read the WorldTransform column instead.
+    /// @param[in] entity The entity, holding a Transform.
+    /// @throws std::runtime_error if the entity has no Transform component.
+    /// @return The up to date WorldTransform of the entity.
+    static const WorldTransform& GetWorldTransform(const flecs::entity entity);
+
+    /// @brief Recomputes cached world matrices if the transform or its parent changed since they were computed.
+    /// @param[in,out] world The cache to refresh.
+    /// @param[in] parent The parent entity whose cache is passed, 0 for none.
+    /// @param[in] parentWorld The up to date cache of the parent, nullptr for none.
+    /// @return True if the matrices were recomputed.
+    bool RefreshWorldTransform(WorldTransform& world, const flecs::entity_t parent, const WorldTransform* const parentWorld) const;
+
+    /// @brief Refreshes the caches of transforms sharing a parent, composing the stale ones together with TransformBatch.
+    /// @param[in] count The number of transforms.
+    /// @param[in] transforms The transforms, such as a column of a flecs table.
+    /// @param[in,out] worlds The cache of every transform.
+    /// @param[in] parent The parent entity whose cache is passed, 0 for none.
+    /// @param[in] parentWorld The up to date cache of the parent, nullptr for none.
+    /// @return The number of caches recomputed.
+    static size_t RefreshWorldTransforms(const size_t count, const Transform* const transforms, WorldTransform* const worlds,
+        const flecs::entity_t parent, const WorldTransform* const parentWorld);
+
+    /// @brief Computes the matrix from the local space of the entity to the space of its parent.
+    /// @return The translation, rotation and scale matrix.
+    glm::mat4 GetLocalMatrix() const;
+
+    /// @brief Computes the matrix from the local space of the entity to the space of its parent, ignoring scale.
+    /// @return The translation and rotation matrix.
+    glm::mat4 GetLocalMatrixNoScale() const;
+
+    /// @brief Calculates the render matrix of an entity for perspective camera rendering.
+    /// @param[in] entity The entity, holding a Transform.
+    /// @param[in] cameraEntity The camera entity, holding a Transform.
     /// @param[in] perspectiveCamera The PerspectiveCamera component associated with the camera.
     /// @return The render matrix combining the model, view, and projection matrices.
-    glm::mat4 GetRenderMatrix(const Transform* const cameraTransform, const PerspectiveCamera* const perspectiveCamera) const;
+    static glm::mat4 GetRenderMatrix(const flecs::entity entity, const flecs::entity cameraEntity, const PerspectiveCamera* const perspectiveCamera);
 
-    /// @brief Calculates the render matrix for orthographic camera rendering.
-    /// @param[in] cameraTransform The Transform component of the camera.
+    /// @brief Calculates the render matrix of an entity for orthographic camera rendering.
+    /// @param[in] entity The entity, holding a Transform.
+    /// @param[in] cameraEntity The camera entity, holding a Transform.
     /// @param[in] orthoCamera The OrthoCamera component associated with the camera.
     /// @return The render matrix combining the model, view, and projection matrices.
-    glm::mat4 GetRenderMatrix(const Transform* const cameraTransform, const OrthoCamera* const orthoCamera) const;
-
-    const Vec2 GetScreenPosition(const Transform* const cameraTransform, const PerspectiveCamera* const perspectiveCamera) const;
+    static glm::mat4 GetRenderMatrix(const flecs::entity entity, const flecs::entity cameraEntity, const OrthoCamera* const orthoCamera);
+
+    static const Vec2 GetScreenPosition(const flecs::entity entity, const flecs::entity cameraEntity, const PerspectiveCamera* const perspectiveCamera);
+
+    /// @brief Projects the world positions of many entities to the screen at once, with the main camera of the frame.
+    ///
+    /// The CameraData and MainCamera singletons are read once for the whole batch, see ScreenProjection.
+    /// @param[in] ecs The world holding the CameraData and MainCamera singletons.
+    /// @param[in] count The number of entities.
+    /// @param[in] worlds The cached world matrices of the entities, such as the WorldTransform column of a flecs table.
+    /// @param[out] screenPositions The position of every entity on the screen, in pixels.
+    /// @param[out] clipFlags The ScreenProjection::Clip bits of every entity, nullptr to skip them.
+    /// @throws std::runtime_error if the CameraData or MainCamera singleton is missing.
+    static void GetScreenPositions(const flecs::world& ecs, const size_t count, const WorldTransform* const worlds,
+        Vec2* const screenPositions, uint8_t* const clipFlags);
 
 protected:
     // Protected Fields
@@ -124,7 +215,14 @@ protected:
 private:
     // Private Fields
 
+    glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f}; /// @brief The local rotation of the entity, normalized.
+
     // Private Methods
+
+    /// @brief Checks whether the local position, rotation or scale differ from those a cache was computed from.
+    /// @param[in] world The cache.
+    /// @return True if the local matrix has to be composed again.
+    bool HasLocalChanged(const WorldTransform& world) const;
 };
 
 } // namespace velecs
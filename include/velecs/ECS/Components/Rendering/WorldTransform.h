@@ -0,0 +1,69 @@
+/// @file    WorldTransform.h
+/// @author  Matthew Green
+/// @date    2026-10-18 05:31:09
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Math/Vec3.h"
+
+#include <flecs.h>
+
+#include <glm/mat4x4.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct WorldTransform
+/// @brief Cached world matrices of a Transform, added alongside every Transform.
+///
+/// The cache remembers the local position, rotation and scale and the parent it was computed from,
+/// along with the version of the parent's cache at that time. It is stale once any of them differ,
+/// so a change anywhere up the hierarchy reaches every descendant through the versions alone.
+/// The propagation pass refreshes every cache top-down once per frame, after the Update stages, so
+/// the systems of the later stages read the matrices straight from their iterator. Transform's
+/// getters refresh it on demand for anything changed later in the frame.
+struct WorldTransform {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::mat4 matrix{1.0f}; /// @brief Local to world matrix.
+    glm::mat4 matrixNoScale{1.0f}; /// @brief Local to world matrix ignoring the scale of the entity and its ancestors.
+    glm::mat4 localMatrix{1.0f}; /// @brief Local to parent matrix, reused when only an ancestor moved.
+
+    Vec3 position{Vec3::ZERO}; /// @brief Local position the matrices were computed from.
+    glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f}; /// @brief Local rotation the matrices were computed from.
+    Vec3 scale{Vec3::ONE}; /// @brief Local scale the matrices were computed from.
+
+    flecs::entity_t parent{0}; /// @brief Parent whose cache the matrices were computed from, 0 for none.
+    uint32_t parentVersion{0}; /// @brief Version of the parent's cache the matrices were computed from.
+    uint32_t version{0}; /// @brief Bumped every time the matrices are recomputed, 0 until they first are.
+
+    // Constructors and Destructors
+
+    // Public Methods
+
+    /// @brief Marks the matrices as recomputed, for the caches of the children to notice.
+    inline void BumpVersion() { version = version == UINT32_MAX ? 1 : version + 1; } // 0 is kept for never computed
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
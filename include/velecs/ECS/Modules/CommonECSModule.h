@@ -15,8 +15,12 @@
 
 #include "velecs/ECS/Components/Rendering/Transform.h"
 
+#include "velecs/Core/JobSystem.h"
+
 #include <flecs.h>
 
+#include <memory>
+
 namespace velecs {
 
 /// @struct CommonECSModule
@@ -39,6 +43,19 @@ public:
 
     // Public Methods
 
+    /// @brief Registers WorldTransform alongside Transform and the system refreshing every WorldTransform top-down.
+    /// @param[in] ecs The world to register in.
+    /// @param[in] phase The phase the system runs in, or a null entity to only run it manually.
+    /// @param[in] jobSystem The threads the depth levels are spread over, see TransformPropagation. nullptr runs on the calling thread.
+    /// @return The propagation system.
+    static flecs::system InitTransformPropagation(flecs::world& ecs, const flecs::entity phase, JobSystem* const jobSystem = nullptr);
+
+    /// @brief Gets the engine's worker threads, shared by every module spreading work over threads.
+    /// @param[in] ecs The world the CommonECSModule was imported in.
+    /// @return The job system, alive as long as the world is.
+    /// @throws std::runtime_error if the CommonECSModule was not imported.
+    static JobSystem& GetJobSystem(flecs::world& ecs);
+
 protected:
     // Protected Fields
 
@@ -47,6 +64,8 @@ protected:
 private:
     // Private Fields
 
+    std::unique_ptr<JobSystem> _jobSystem; /// @brief Engine's worker threads, propagating the transforms and recording the render queue.
+
     // Private Methods
 };
 
@@ -12,10 +12,23 @@
 
 #include "velecs/ECS/Modules/IECSModule.h"
 
+#include "velecs/Core/JobSystem.h"
+
 #include "velecs/Memory/DeletionQueue.h"
-#include "velecs/Memory/UploadContext.h"
 #include "velecs/Memory/AllocatedImage.h"
 
+#include "velecs/Rendering/FrameData.h"
+#include "velecs/Rendering/InstanceData.h"
+#include "velecs/Rendering/RenderQueue.h"
+#include "velecs/Rendering/RenderStats.h"
+#include "velecs/Rendering/MeshArena.h"
+#include "velecs/Rendering/MeshUploader.h"
+#include "velecs/Rendering/GPUCullingPass.h"
+#include "velecs/Rendering/DepthPyramid.h"
+#include "velecs/Rendering/GPUProfiler.h"
+#include "velecs/Rendering/FramePacer.h"
+#include "velecs/Rendering/PipelineCache.h"
+
 #include "velecs/Math/Vec2.h"
 #include "velecs/Math/Vec3.h"
 
@@ -26,6 +39,8 @@
 #include "velecs/ECS/Components/Rendering/PerspectiveCamera.h"
 #include "velecs/ECS/Components/Rendering/OrthoCamera.h"
 #include "velecs/ECS/Components/Rendering/MainCamera.h"
+#include "velecs/ECS/Components/Rendering/CameraData.h"
+#include "velecs/ECS/Components/Rendering/RenderSettings.h"
 
 #include <vulkan/vulkan.h>
 
@@ -33,6 +48,11 @@
 
 #include <VkBootstrap.h>
 
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <imgui.h>
@@ -63,6 +83,10 @@ public:
 
     void OnWindowMinimize() const;
 
+    /// @brief Requests the swapchain to be recreated at the window's new size.
+    ///
+    /// Requests are coalesced, however many arrive during a frame the swapchain is recreated once,
+    /// at the start of the next frame.
     void OnWindowResize();
 
     static flecs::entity CreatePerspectiveCamera
@@ -90,6 +114,26 @@ public:
 
     const Rect RenderingECSModule::GetWindowExtent() const;
 
+    /// @brief Changes the present mode. The swapchain is recreated at the start of the next frame.
+    /// @param[in] presentMode The requested mode, falls back to the closest mode the surface supports.
+    void SetPresentMode(const VkPresentModeKHR presentMode);
+
+    /// @brief Gets the present mode the swapchain was created with.
+    /// @return The mode actually in use, which may differ from the requested one.
+    inline VkPresentModeKHR GetPresentMode() const { return _presentMode; }
+
+    /// @brief Turns the low latency frame pacing on or off.
+    /// @param[in] lowLatency True to keep no frame queued and delay input sampling until just in time.
+    void SetLowLatency(const bool lowLatency);
+
+    /// @brief Gets the averaged time from input sampling to the frame being handed to the presentation engine.
+    /// @return The latency in milliseconds.
+    inline float GetInputToPresentMs() const { return _framePacer.GetInputToPresentMs(); }
+
+    /// @brief Gets the GPU timings of the render passes, for logging.
+    /// @return The profiler, whose timings lag a few frames behind the frame being recorded.
+    inline const GPUProfiler& GetGPUProfiler() const { return _gpuProfiler; }
+
 protected:
     // Protected Fields
 
@@ -100,8 +144,14 @@ private:
 
     int _frameNumber{0}; /// @brief Keeps track of the current frame number.
 
+    RenderSettings _settings; /// @brief Copy of the RenderSettings singleton taken at construction.
+
     bool shouldRender{true};
 
+    bool _headless{false}; /// @brief True if rendering into _offscreenImage instead of a swapchain.
+    AllocatedImage _offscreenImage; /// @brief Color target of headless mode, stands in for the swapchain image.
+    std::chrono::high_resolution_clock::time_point _headlessStart; /// @brief When the first headless frame began.
+
     SDL_Window* _window{nullptr}; /// @brief Pointer to the SDL window structure.
 
     VkExtent2D windowExtent{1700, 900}; /// @brief Desired dimensions of the rendering window.
@@ -117,19 +167,26 @@ private:
     std::vector<VkImage> _swapchainImages; /// @brief List of images within the swapchain.
     std::vector<VkImageView> _swapchainImageViews; /// @brief List of image views for accessing swapchain images.
     uint32_t swapchainImageIndex{0};
+    bool _swapchainDirty{false}; /// @brief True if the swapchain has to be recreated before the next image is acquired.
+    bool _frameSkipped{false}; /// @brief True if there is no swapchain to render into, the current frame records and presents nothing.
+    VkPresentModeKHR _presentMode{VK_PRESENT_MODE_FIFO_KHR}; /// @brief Present mode the swapchain was created with.
+    FramePacer _framePacer; /// @brief Input-to-present latency measurement and low latency input timing.
 
     VkQueue _graphicsQueue{VK_NULL_HANDLE}; /// @brief Queue used for submitting graphics commands.
     uint32_t _graphicsQueueFamily{0}; /// @brief Index of the queue family for graphics operations.
-    VkCommandPool _commandPool{VK_NULL_HANDLE}; /// @brief Pool for allocating command buffers.
-    VkCommandBuffer _mainCommandBuffer{VK_NULL_HANDLE}; /// @brief Main command buffer for recording rendering commands.
+
+    VkQueue _transferQueue{VK_NULL_HANDLE}; /// @brief Queue used for mesh uploads. Dedicated when the device has one, the graphics queue otherwise.
+    uint32_t _transferQueueFamily{0}; /// @brief Index of the queue family of _transferQueue.
+
+    PFN_vkCmdDrawIndexedIndirectCount _drawIndexedIndirectCount{nullptr}; /// @brief vkCmdDrawIndexedIndirectCount when the device supports it, nullptr otherwise.
+    bool _multiDrawIndirect{false}; /// @brief True if indirect draws may issue more than one command.
+
+    std::vector<FrameData> _frames; /// @brief Ring of per-frame contexts, one per frame in flight.
 
     VkRenderPass _renderPass{VK_NULL_HANDLE}; /// @brief Handle to the Vulkan render pass.
     std::vector<VkFramebuffer> _framebuffers; /// @brief List of framebuffers for rendering.
 
-    VkSemaphore _presentSemaphore{VK_NULL_HANDLE}, _renderSemaphore{VK_NULL_HANDLE}; /// @brief Semaphore for synchronizing image presentation.
-    VkFence _renderFence{VK_NULL_HANDLE}; /// @brief Fence for synchronizing rendering operations.
-
-    VkPipeline currentPipeline{VK_NULL_HANDLE};
+    PipelineCache _pipelineCache; /// @brief Persistent cache every pipeline is created with.
 
     std::vector<VkPipeline> pipelines;
     std::vector<VkPipelineLayout> pipelineLayouts;
@@ -137,14 +194,63 @@ private:
     VkPipelineLayout _trianglePipelineLayout{VK_NULL_HANDLE}; /// @brief Handle to the pipeline layout.
     VkPipeline _triangleWireFramePipeline{VK_NULL_HANDLE}; /// @brief Handle to the pipeline.
     VkPipeline _rainbowSimpleMeshPipeline{VK_NULL_HANDLE}; /// @brief Handle to the pipeline.
+    VkPipeline _rainbowSimpleMeshInstancedPipeline{VK_NULL_HANDLE}; /// @brief Handle to the instanced variant of the rainbow pipeline.
+    VkPipeline _rainbowSimpleMeshIndirectPipeline{VK_NULL_HANDLE}; /// @brief Handle to the GPU-driven variant of the rainbow pipeline.
 
     VkPipelineLayout _meshPipelineLayout{VK_NULL_HANDLE};
     VkPipeline _meshPipeline{VK_NULL_HANDLE};
 
     VkPipelineLayout simpleMeshPipelineLayout{VK_NULL_HANDLE};
     VkPipeline simpleMeshPipeline{VK_NULL_HANDLE};
-
-    UploadContext _uploadContext;
+    VkPipeline simpleMeshInstancedPipeline{VK_NULL_HANDLE}; /// @brief Handle to the instanced variant of the solid color pipeline.
+    VkPipeline simpleMeshIndirectPipeline{VK_NULL_HANDLE}; /// @brief Handle to the GPU-driven variant of the solid color pipeline.
+
+    /// @struct QueuedDraw
+    /// @brief A draw call of the sorted render queue, recorded by one of the recording jobs.
+    struct QueuedDraw {
+        uint32_t command; /// @brief Index of the first sorted command drawn.
+        uint32_t instanceCount; /// @brief Instances drawn from the instance buffer, 0 for a push constant draw.
+        uint32_t firstInstance; /// @brief First instance of the batch in the instance buffer.
+    };
+
+    /// @struct RecordingContext
+    /// @brief State of one command buffer while a slice of the render queue is recorded into it.
+    struct RecordingContext {
+        VkCommandBuffer cmd{VK_NULL_HANDLE};
+        VkPipeline currentPipeline{VK_NULL_HANDLE}; /// @brief Last pipeline bound in cmd.
+        VkPipelineLayout currentLayout{VK_NULL_HANDLE}; /// @brief Layout the camera set was last bound with.
+        VkIndexType currentIndexType{VK_INDEX_TYPE_UINT32}; /// @brief Index type the mesh arena's index buffer was last bound with.
+        RenderStats stats; /// @brief Binds and draws recorded into cmd.
+        uint32_t batchScope{GPUProfiler::INVALID_SCOPE}; /// @brief GPU timing scope of the material batch being recorded.
+    };
+
+    static constexpr uint32_t MIN_DRAWS_PER_RECORDING_JOB = 128; /// @brief Below this, splitting the queue costs more than it saves.
+
+    RenderQueue _renderQueue; /// @brief Draw commands extracted during the current frame.
+    std::vector<QueuedDraw> _queuedDraws; /// @brief Draw calls of the sorted render queue, rebuilt every frame.
+    std::vector<RecordingContext> _recordingContexts; /// @brief One per recording job of the current frame.
+    JobSystem* _jobSystem{nullptr}; /// @brief Engine's worker threads, owned by the CommonECSModule, recording the render queue.
+    RenderStats _renderStats; /// @brief Counters of the frame being recorded.
+    RenderStats _lastRenderStats; /// @brief Counters of the last completed frame, shown by DisplayRenderStats.
+
+    MeshArena _meshArena; /// @brief Shared vertex and index buffers every SimpleMesh is uploaded into.
+    MeshUploader _meshUploader; /// @brief Asynchronous upload service filling _meshArena.
+    std::shared_ptr<std::vector<std::pair<MeshRange, uint64_t>>> _releasedMeshes{std::make_shared<std::vector<std::pair<MeshRange, uint64_t>>>()}; /// @brief Ranges of removed or overwritten meshes and their upload tickets, freed once no frame in flight draws them.
+
+    bool _gpuDriven{false}; /// @brief True if materials with an indirect pipeline go through _gpuCulling.
+    GPUCullingPass _gpuCulling; /// @brief Compute culling and indirect draws of the GPU-driven materials.
+    CameraData _cameraData; /// @brief Main camera of the frame being recorded, also set as a singleton.
+    DepthPyramid _depthPyramid; /// @brief Hi-Z pyramid of the previous frame's depth, used by _gpuCulling for occlusion culling.
+    bool _depthHistoryValid{false}; /// @brief True if the depth image holds the previous frame's depth.
+    bool _hasPreviousCamera{false}; /// @brief True if _cameraData holds the previous frame's camera when UpdateCameraData runs.
+
+    GPUProfiler _gpuProfiler; /// @brief Timestamp queries around the passes and material batches.
+    uint32_t _frameScope{GPUProfiler::INVALID_SCOPE}; /// @brief GPU timing scope of the whole frame.
+    uint32_t _mainPassScope{GPUProfiler::INVALID_SCOPE}; /// @brief GPU timing scope of the main render pass.
+    std::unordered_map<VkPipeline, std::string> _pipelineNames; /// @brief Material name of every pipeline, used to name the batch scopes.
+
+    VkDescriptorPool _descriptorPool{VK_NULL_HANDLE}; /// @brief Pool of the per-frame descriptor sets.
+    VkDescriptorSetLayout _cameraSetLayout{VK_NULL_HANDLE}; /// @brief Layout of set 0 of the mesh pipelines, a single CameraData uniform buffer.
 
     DeletionQueue _mainDeletionQueue;
 
@@ -170,10 +276,34 @@ private:
     ///
     /// This method sets up the swapchain which is critical for rendering frames to the screen.
     /// It is called by the Init method during engine initialization.
-    void InitSwapchain();
+    /// @param[in] oldSwapchain The swapchain being replaced, or VK_NULL_HANDLE. It is retired, not destroyed.
+    /// @return True if the swapchain was created, false if building it failed and _swapchain was left untouched.
+    bool InitSwapchain(VkSwapchainKHR oldSwapchain = VK_NULL_HANDLE);
+
+    /// @brief Picks the requested present mode if the surface supports it, or the closest one it does.
+    /// @param[in] requested The present mode asked for in the RenderSettings.
+    /// @return A present mode supported by _surface.
+    VkPresentModeKHR ChoosePresentMode(const VkPresentModeKHR requested) const;
+
+    /// @brief Gets a readable name of a present mode.
+    /// @param[in] presentMode The present mode.
+    /// @return The name of the mode without its VK_PRESENT_MODE_ prefix.
+    static const char* GetPresentModeName(const VkPresentModeKHR presentMode);
+
+    /// @brief Replaces the swapchain, depth image and framebuffers with ones matching the window, without waiting for the device.
+    ///
+    /// The old resources may still be used by frames in flight, they are handed to the current frame's
+    /// deletion queue and destroyed once its fence proves every earlier submission has completed.
+    void RecreateSwapchain();
 
     void CleanupSwapchain();
 
+    /// @brief Creates the color image headless mode renders into, in place of the swapchain images.
+    void InitOffscreenImage();
+
+    /// @brief Creates the depth image matching windowExtent.
+    void InitDepthImage();
+
     /// @brief Initializes command buffers and pools for rendering.
     ///
     /// This method sets up the command pool and main command buffer used for rendering.
@@ -200,6 +330,33 @@ private:
     /// It is called by the Init method during engine initialization.
     void InitSyncStructures();
 
+    /// @brief Creates the camera set layout and the per-frame camera uniform buffers and descriptor sets.
+    void InitDescriptors();
+
+    /// @brief Loads the pipeline cache from the game directory, it is written back on shutdown.
+    void InitPipelineCache();
+
+    /// @brief Creates the mesh arena and its upload service, sized from the RenderSettings.
+    void InitMeshArena();
+
+    /// @brief Creates the GPU culling pass when GPU-driven rendering is enabled.
+    void InitGPUCulling();
+
+    /// @brief Creates the timestamp query pools of the GPU profiler when GPU profiling is enabled.
+    void InitGPUProfiler();
+
+    /// @brief Gets the name GPU timing scopes of a pipeline's batches are given.
+    /// @param[in] pipeline The pipeline.
+    /// @return The name of the material the pipeline belongs to.
+    const char* GetPipelineName(const VkPipeline pipeline) const;
+
+    /// @brief Gets the per-frame context of the frame currently being recorded.
+    /// @return The FrameData at _frameNumber modulo the number of frames in flight.
+    FrameData& GetCurrentFrame();
+
+    /// @brief Blocks until every frame in flight has finished executing on the GPU.
+    void WaitForAllFrames();
+
     /// @brief Initializes the rendering pipelines by loading shader modules.
     ///
     /// This method loads the shader modules necessary for rendering, including a vertex shader and a fragment shader for rendering triangles.
@@ -216,24 +373,85 @@ private:
 
     void PreDrawStep(float deltaTime);
 
+    /// @brief Computes the CameraData of the main camera and uploads it to the current frame's uniform buffer.
+    /// @throws std::runtime_error if the main camera has neither a PerspectiveCamera nor an OrthoCamera.
+    void UpdateCameraData();
+
+    /// @brief Picks the level of detail of a mesh from its projected size in the main camera.
+    /// @param[in] mesh The mesh to draw.
+    /// @param[in] world The local to world matrix of the entity.
+    /// @return The coarsest level whose error stays below RenderSettings::lodThresholdPixels on screen.
+    uint32_t SelectLOD(const SimpleMesh& mesh, const glm::mat4& world) const;
+
+    /// @brief Begins the main render pass and binds the state shared by every draw of the frame.
+    void BeginMainRenderPass();
+
+    /// @brief Records the GPU culling dispatches of the objects gathered this frame. Must run before BeginMainRenderPass.
+    void RecordGPUCulling();
+
+    /// @brief Records the indirect draws of the GPU-driven materials.
+    void SubmitGPUDrivenDraws();
+
+    /// @brief Checks whether a material is culled and drawn by the GPUCullingPass.
+    /// @param[in] material The material to check.
+    /// @return True if GPU-driven rendering is enabled and the material has an indirect pipeline.
+    inline bool IsGPUDriven(const Material& material) const
+    {
+        return _gpuDriven && material.indirectPipeline != nullptr && *material.indirectPipeline != VK_NULL_HANDLE;
+    }
+
     void PostDrawStep(float deltaTime);
 
-    void BindPipeline(const Material& material);
+    /// @brief Begins a secondary command buffer continuing the main render pass and binds the state shared by every draw.
+    /// @param[in] cmd The secondary command buffer to begin.
+    void BeginSecondaryCommandBuffer(VkCommandBuffer cmd) const;
 
-    void Draw
-    (
-        const float deltaTime,
-        const glm::mat4 renderMatrix,
-        const SimpleMesh& mesh,
-        const Material& material
-    );
+    /// @brief Binds a graphics pipeline.
+    /// @param[in,out] context The command buffer to record into.
+    /// @param[in] pipeline The pipeline to bind.
+    void BindPipeline(RecordingContext& context, const VkPipeline pipeline) const;
 
+    /// @brief Records a single, non-instanced draw.
+    /// @param[in,out] context The command buffer to record into.
+    /// @param[in] command The command to draw. Its pipeline must already be bound.
+    void Draw(RecordingContext& context, const DrawCommand& command) const;
+
+    /// @brief Sorts the render queue and records it, eliding redundant pipeline binds and merging instanced commands.
+    ///
+    /// The draw calls are split into contiguous slices recorded in parallel into secondary command buffers,
+    /// then executed in order by the main command buffer.
+    void SubmitRenderQueue();
+
+    /// @brief Records a slice of _queuedDraws into a secondary command buffer. Called from the recording threads.
+    /// @param[in] job The index of the slice.
+    /// @param[in] jobCount The number of slices.
+    void RecordRenderQueueSlice(const uint32_t job, const uint32_t jobCount);
+
+    /// @brief Grows the frame's instance buffer so it can hold at least instanceCount instances.
+    /// @param[in] frame The frame owning the instance buffer.
+    /// @param[in] instanceCount The number of instances required.
+    void ReserveInstanceBuffer(FrameData& frame, const uint32_t instanceCount);
+
+    /// @brief Queues the asynchronous upload of a mesh into the mesh arena.
+    /// @param[in,out] mesh The mesh to upload.
+    /// @return True if the upload was queued, false if it has to be retried next frame.
     template<typename TMesh>
-    void UploadMesh(TMesh& mesh);
+    bool UploadMesh(TMesh& mesh);
 
-    void ImmediateSubmit(std::function<void(VkCommandBuffer cmd)>&& function);
+    /// @brief Frees the ranges released so far once the frame just submitted has retired.
+    /// @param[in] frame The frame that was just submitted.
+    void DeferMeshReleases(FrameData& frame);
 
     void DisplayFPSCounter() const;
+
+    /// @brief Displays the counters of the last submitted render queue.
+    void DisplayRenderStats() const;
+
+    /// @brief Displays the present mode and latency controls and the measured input-to-present latency.
+    void DisplayPresentSettings();
+
+    /// @brief Displays the averaged GPU time of every pass as a table with a graph of its history.
+    void DisplayGPUProfiler() const;
 };
 
 } // namespace velecs
@@ -0,0 +1,93 @@
+/// @file    TransformPropagation.h
+/// @author  Matthew Green
+/// @date    2026-10-18 07:15:46
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/ECS/Components/Rendering/Transform.h"
+#include "velecs/ECS/Components/Rendering/WorldTransform.h"
+
+#include <flecs.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace velecs {
+
+class JobSystem;
+
+/// @class TransformPropagation
+/// @brief Refreshes the WorldTransform of every entity top-down, spread over the threads of a JobSystem.
+///
+/// The tables are split by depth: every table of a level only reads the caches of the level above, so
+/// the levels run one after the other and the tables of a level run in parallel without any lock.
+/// Large tables are cut into chunks and small ones grouped, so deep and wide hierarchies both
+/// keep every thread busy.
+class TransformPropagation {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr int32_t CHUNK_SIZE = 2048; /// @brief Most entities of a table a thread refreshes at a time.
+    static constexpr uint32_t MIN_GROUP_SIZE = 64; /// @brief Fewest entities a thread takes at a time, small tables are grouped until they reach it.
+
+    // Constructors and Destructors
+
+    /// @brief Creates the query visiting every Transform top-down.
+    /// @param[in] ecs The world holding the transforms.
+    /// @param[in] jobSystem The threads to spread the work over, nullptr to refresh on the calling thread only.
+    TransformPropagation(flecs::world& ecs, JobSystem* const jobSystem);
+
+    /// @brief Default deconstructor.
+    ~TransformPropagation() = default;
+
+    // Public Methods
+
+    /// @brief Refreshes every stale WorldTransform.
+    void Run();
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    /// @struct Job
+    /// @brief A slice of a table, whose entities share a parent.
+    struct Job {
+        const Transform* transforms{nullptr};
+        WorldTransform* worlds{nullptr};
+        const WorldTransform* parentWorld{nullptr};
+        flecs::entity_t parent{0};
+        uint32_t count{0};
+    };
+
+    flecs::query<const Transform, const WorldTransform*, WorldTransform> query;
+    JobSystem* jobSystem{nullptr};
+
+    std::vector<std::vector<Job>> levels; /// @brief The jobs of every depth, kept from frame to frame to reuse their memory.
+    std::unordered_map<const ecs_table_t*, uint32_t> tableLevels; /// @brief Depth of every table visited this frame.
+    std::vector<std::pair<uint32_t, uint32_t>> groups; /// @brief First and last jobs of every group of the level running.
+
+    // Private Methods
+
+    /// @brief Collects the jobs of every level, reading the tables in the order of the query.
+    void Gather();
+
+    /// @brief Runs the jobs of a level in parallel.
+    /// @param[in] jobs The jobs, none of them reads a cache another one writes.
+    void RunLevel(const std::vector<Job>& jobs);
+};
+
+} // namespace velecs
@@ -0,0 +1,110 @@
+/// @file    Bounds.h
+/// @author  Matthew Green
+/// @date    2026-10-17 22:41:27
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <glm/vec3.hpp>
+#include <glm/mat4x4.hpp>
+
+namespace velecs {
+
+/// @struct AABB
+/// @brief Axis-aligned bounding box.
+struct AABB {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::vec3 min{0.0f}; /// @brief Corner with the smallest coordinates.
+    glm::vec3 max{0.0f}; /// @brief Corner with the largest coordinates.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    AABB() = default;
+
+    /// @brief Constructor.
+    /// @param[in] min Corner with the smallest coordinates.
+    /// @param[in] max Corner with the largest coordinates.
+    AABB(const glm::vec3 min, const glm::vec3 max);
+
+    /// @brief Default deconstructor.
+    ~AABB() = default;
+
+    // Public Methods
+
+    /// @brief Gets the center of the box.
+    /// @return The center.
+    glm::vec3 GetCenter() const;
+
+    /// @brief Gets half the size of the box along every axis.
+    /// @return The half extents.
+    glm::vec3 GetExtents() const;
+
+    /// @brief Computes the box enclosing this box once transformed.
+    /// @param[in] matrix The affine transformation to apply.
+    /// @return The transformed, still axis-aligned, box.
+    AABB Transform(const glm::mat4& matrix) const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+/// @struct BoundingSphere
+/// @brief Sphere enclosing a set of points.
+struct BoundingSphere {
+public:
+    // Enums
+
+    // Public Fields
+
+    glm::vec3 center{0.0f}; /// @brief Center of the sphere.
+    float radius{0.0f}; /// @brief Radius of the sphere.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    BoundingSphere() = default;
+
+    /// @brief Constructor.
+    /// @param[in] center Center of the sphere.
+    /// @param[in] radius Radius of the sphere.
+    BoundingSphere(const glm::vec3 center, const float radius);
+
+    /// @brief Default deconstructor.
+    ~BoundingSphere() = default;
+
+    // Public Methods
+
+    /// @brief Computes the sphere enclosing this sphere once transformed.
+    /// @param[in] matrix The affine transformation to apply.
+    /// @return The transformed sphere, its radius scaled by the largest axis scale of matrix.
+    BoundingSphere Transform(const glm::mat4& matrix) const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
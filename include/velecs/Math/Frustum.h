@@ -0,0 +1,84 @@
+/// @file    Frustum.h
+/// @author  Matthew Green
+/// @date    2026-10-17 22:52:14
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Math/Bounds.h"
+
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <array>
+
+namespace velecs {
+
+/// @struct Frustum
+/// @brief The six planes bounding the volume visible through a camera.
+///
+/// Every plane is stored as (normal, distance) with its normal pointing inside the frustum,
+/// so a point p is inside a plane when dot(normal, p) + distance >= 0.
+struct Frustum {
+public:
+    // Enums
+
+    /// @enum Plane
+    /// @brief Index of each plane in planes.
+    enum Plane
+    {
+        Left = 0,
+        Right,
+        Bottom,
+        Top,
+        Near,
+        Far,
+        Count
+    };
+
+    // Public Fields
+
+    std::array<glm::vec4, Plane::Count> planes; /// @brief Normalized planes of the frustum.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    Frustum() = default;
+
+    /// @brief Default deconstructor.
+    ~Frustum() = default;
+
+    // Public Methods
+
+    /// @brief Extracts the planes of a view-projection matrix.
+    /// @param[in] viewProjection The projection matrix multiplied by the view matrix. Clip space depth is expected in [0, w].
+    /// @return The frustum, in the space the matrix transforms from.
+    static Frustum FromMatrix(const glm::mat4& viewProjection);
+
+    /// @brief Checks whether a sphere is at least partially inside the frustum.
+    /// @param[in] sphere The sphere to test.
+    /// @return False if the sphere is entirely outside one of the planes.
+    bool Intersects(const BoundingSphere& sphere) const;
+
+    /// @brief Checks whether a box is at least partially inside the frustum.
+    /// @param[in] box The box to test.
+    /// @return False if the box is entirely outside one of the planes.
+    bool Intersects(const AABB& box) const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -14,6 +14,8 @@
 #include <iomanip>
 
 #include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 namespace velecs {
 
@@ -40,6 +42,38 @@ public:
     // Static method to convert glm::mat4 to a formatted string.
     static std::string ToString(const glm::mat4& mat);
 
+    /// @brief Converts Euler angles to the quaternion rotating about X, then Y, then Z in local space.
+    /// @param[in] degrees The rotation about each axis, in degrees.
+    /// @return The normalized quaternion of the rotation matrix Rx * Ry * Rz.
+    static glm::quat EulerToQuat(const glm::vec3& degrees);
+
+    /// @brief Converts a quaternion to the Euler angles EulerToQuat builds it from.
+    ///
+    /// Y is kept within [-90, 90] degrees. At either end Z is 0 and X carries the whole roll.
+    /// @param[in] rotation The normalized quaternion.
+    /// @return The rotation about each axis, in degrees.
+    static glm::vec3 QuatToEuler(const glm::quat& rotation);
+
+    /// @brief Composes a translation, rotation and scale matrix in one pass.
+    /// @param[in] translation The translation.
+    /// @param[in] rotation The normalized rotation.
+    /// @param[in] scale The scale along each local axis.
+    /// @return The matrix T * R * S.
+    static glm::mat4 ComposeTRS(const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale);
+
+    /// @brief Multiplies two matrices whose last row is (0, 0, 0, 1), skipping the products with it.
+    /// @param[in] a The left matrix.
+    /// @param[in] b The right matrix.
+    /// @return The matrix a * b, its last row (0, 0, 0, 1) as well.
+    static glm::mat4 MultiplyAffine(const glm::mat4& a, const glm::mat4& b);
+
+    /// @brief Interpolates between two rotations at constant angular speed along the shorter arc.
+    /// @param[in] from The rotation at t = 0.
+    /// @param[in] to The rotation at t = 1.
+    /// @param[in] t The interpolation factor.
+    /// @return The normalized interpolated rotation.
+    static glm::quat Slerp(const glm::quat& from, const glm::quat& to, const float t);
+
 protected:
     // Protected Fields
 
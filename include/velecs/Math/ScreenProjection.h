@@ -0,0 +1,93 @@
+/// @file    ScreenProjection.h
+/// @author  Matthew Green
+/// @date    2026-10-18 06:58:24
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Math/Vec2.h"
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace velecs {
+
+/// @class ScreenProjection
+/// @brief Projects many world positions to the screen at once, such as the anchors of nameplates and markers.
+///
+/// The view projection matrix and the resolution are read once for the whole batch, and 4 positions are
+/// projected per instruction on x86-64 CPUs. Every position gets clip flags telling whether it is visible.
+class ScreenProjection {
+public:
+    // Enums
+
+    /// @enum Clip
+    /// @brief Bits of the clip flags, set where a position lies outside the view volume. 0 means visible.
+    enum Clip : uint8_t {
+        Visible = 0,          /// @brief Inside the view volume.
+        Behind = 1 << 0,      /// @brief At or behind the camera, its screen position is meaningless.
+        Left = 1 << 1,        /// @brief Left of the viewport.
+        Right = 1 << 2,       /// @brief Right of the viewport.
+        Top = 1 << 3,         /// @brief Above the viewport, Vulkan's clip space y points down.
+        Bottom = 1 << 4,      /// @brief Below the viewport.
+        Near = 1 << 5,        /// @brief Closer than the near plane.
+        Far = 1 << 6          /// @brief Beyond the far plane.
+    };
+
+    // Public Fields
+
+    // Deleted constructors and assignment operators
+    ScreenProjection() = delete;
+    ~ScreenProjection() = delete;
+    ScreenProjection(const ScreenProjection&) = delete;
+    ScreenProjection(ScreenProjection&&) = delete;
+    ScreenProjection& operator=(const ScreenProjection&) = delete;
+    ScreenProjection& operator=(ScreenProjection&&) = delete;
+
+    // Public Methods
+
+    /// @brief Projects world positions to the screen, the way Transform::GetScreenPosition does.
+    /// @param[in] viewProjection The camera's projection multiplied by its view, as cached in CameraData.
+    /// @param[in] resolution The size of the viewport in pixels.
+    /// @param[in] count The number of positions.
+    /// @param[in] positions The world positions.
+    /// @param[out] screenPositions The position of every point on the screen, in pixels.
+    /// @param[out] clipFlags The Clip bits of every point, nullptr to skip them.
+    static void Project(const glm::mat4& viewProjection, const Vec2 resolution, const size_t count,
+        const glm::vec3* const positions, Vec2* const screenPositions, uint8_t* const clipFlags);
+
+    /// @brief Projects world positions laid out with a stride to the screen, such as the translations of cached world matrices.
+    /// @param[in] viewProjection The camera's projection multiplied by its view, as cached in CameraData.
+    /// @param[in] resolution The size of the viewport in pixels.
+    /// @param[in] count The number of positions.
+    /// @param[in] positions The x of the first position, followed by its y and z.
+    /// @param[in] stride The number of floats from one position to the next.
+    /// @param[out] screenPositions The position of every point on the screen, in pixels.
+    /// @param[out] clipFlags The Clip bits of every point, nullptr to skip them.
+    static void Project(const glm::mat4& viewProjection, const Vec2 resolution, const size_t count,
+        const float* const positions, const size_t stride, Vec2* const screenPositions, uint8_t* const clipFlags);
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+
+    /// @brief Projects positions one at a time, for CPUs without SSE and the remainder of a batch.
+    static void ProjectScalar(const glm::mat4& viewProjection, const Vec2 resolution, const size_t count,
+        const float* const positions, const size_t stride, Vec2* const screenPositions, uint8_t* const clipFlags);
+};
+
+} // namespace velecs
@@ -0,0 +1,117 @@
+/// @file    TransformBatch.h
+/// @author  Matthew Green
+/// @date    2026-10-18 06:40:12
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstddef>
+
+namespace velecs {
+
+/// @class TransformBatch
+/// @brief Composes the matrices of many transforms sharing a parent, several entities per instruction.
+///
+/// The kernel is picked once from the features of the CPU: 8 entities at a time with AVX, 4 with SSE,
+/// or one at a time where neither is available. Every kernel performs the exact operations of
+/// GLMUtility::ComposeTRS and GLMUtility::MultiplyAffine, in the same order and without fused
+/// multiply-adds, so they produce the same bits as Transform::GetWorldMatrix.
+class TransformBatch {
+public:
+    // Enums
+
+    /// @enum Kernel
+    /// @brief Instruction sets Compose can run with.
+    enum class Kernel {
+        Scalar, /// @brief One entity at a time, available everywhere.
+        SSE,    /// @brief 4 entities at a time, available on every x86-64 CPU.
+        AVX     /// @brief 8 entities at a time, on x86-64 CPUs and operating systems supporting AVX.
+    };
+
+    // Public Fields
+
+    // Deleted constructors and assignment operators
+    TransformBatch() = delete;
+    ~TransformBatch() = delete;
+    TransformBatch(const TransformBatch&) = delete;
+    TransformBatch(TransformBatch&&) = delete;
+    TransformBatch& operator=(const TransformBatch&) = delete;
+    TransformBatch& operator=(TransformBatch&&) = delete;
+
+    // Public Methods
+
+    /// @brief Composes the local, world and world without scale matrices of entities sharing a parent.
+    /// @param[in] count The number of entities.
+    /// @param[in] positions The local position of every entity.
+    /// @param[in] rotations The normalized local rotation of every entity.
+    /// @param[in] scales The local scale of every entity.
+    /// @param[in] parent The world matrix of the parent, identity for roots. Its last row must be (0, 0, 0, 1).
+    /// @param[in] parentNoScale The world matrix without scale of the parent, identity for roots.
+    /// @param[out] locals The local to parent matrix of every entity.
+    /// @param[out] worlds The world matrix of every entity.
+    /// @param[out] worldsNoScale The world matrix without scale of every entity.
+    static void Compose(const size_t count, const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales,
+        const glm::mat4& parent, const glm::mat4& parentNoScale, glm::mat4* locals, glm::mat4* worlds, glm::mat4* worldsNoScale);
+
+    /// @brief Gets the kernel Compose runs with.
+    /// @return The widest supported kernel, unless another one was set.
+    static Kernel GetKernel();
+
+    /// @brief Makes Compose run with a kernel, to compare them.
+    /// @param[in] kernel The kernel to run with.
+    /// @throws std::runtime_error if the kernel is not supported on this CPU.
+    static void SetKernel(const Kernel kernel);
+
+    /// @brief Checks whether a kernel can run on this CPU.
+    /// @param[in] kernel The kernel to check.
+    /// @return True if the kernel was built and the CPU supports its instructions.
+    static bool IsSupported(const Kernel kernel);
+
+    /// @brief Gets the name of a kernel, for logs.
+    /// @param[in] kernel The kernel.
+    /// @return "Scalar", "SSE" or "AVX".
+    static const char* GetKernelName(const Kernel kernel);
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+
+    /// @brief Gets the kernel Compose runs with, picked from the CPU's features on first use.
+    /// @return A reference to the active kernel.
+    static Kernel& ActiveKernel();
+
+    /// @brief Composes entities one at a time through GLMUtility.
+    static void ComposeScalar(const size_t count, const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales,
+        const glm::mat4& parent, const glm::mat4& parentNoScale, glm::mat4* locals, glm::mat4* worlds, glm::mat4* worldsNoScale);
+
+    /// @brief Composes entities 4 at a time, the remainder one at a time. Only called when SSE is supported.
+    static void ComposeSSE(const size_t count, const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales,
+        const glm::mat4& parent, const glm::mat4& parentNoScale, glm::mat4* locals, glm::mat4* worlds, glm::mat4* worldsNoScale);
+
+    /// @brief Composes entities 8 at a time, the remainder one at a time. Only called when AVX is supported.
+    ///
+    /// Defined in its own translation unit, the only one built with AVX enabled.
+    static void ComposeAVX(const size_t count, const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales,
+        const glm::mat4& parent, const glm::mat4& parentNoScale, glm::mat4* locals, glm::mat4* worlds, glm::mat4* worldsNoScale);
+
+    /// @brief Checks whether the AVX translation unit was built with AVX enabled.
+    /// @return False if the compiler did not target AVX, ComposeAVX then falls back to the scalar kernel.
+    static bool IsAVXBuilt();
+};
+
+} // namespace velecs
@@ -0,0 +1,148 @@
+/// @file    TransformBatchKernel.h
+/// @author  Matthew Green
+/// @date    2026-10-18 06:40:12
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cstddef>
+
+namespace velecs {
+
+// Only included by the TransformBatch translation units. Every one of them is built for a different
+// instruction set, so everything here has internal linkage and is never shared between them. Matrices
+// are read and written as raw floats: an inline glm function instantiated here could be the copy the
+// linker keeps for the whole program, with instructions other CPUs lack.
+namespace {
+
+static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "TransformBatch reads glm::vec3 arrays with a stride of 3 floats.");
+static_assert(sizeof(glm::quat) == 4 * sizeof(float), "TransformBatch reads glm::quat arrays with a stride of 4 floats.");
+static_assert(sizeof(glm::mat4) == 16 * sizeof(float), "TransformBatch reads and writes glm::mat4 as 16 floats, column by column.");
+
+/// @brief Composes the matrices of every full group of Lanes::WIDTH entities.
+///
+/// Every register holds one matrix element of Lanes::WIDTH entities. The operations are those of
+/// GLMUtility::ComposeTRS and GLMUtility::MultiplyAffine, in the same order.
+/// @tparam Lanes The instruction set, providing Reg, WIDTH, Broadcast, Load, Add, Sub, Mul and Store.
+/// Store writes one column of Lanes::WIDTH consecutive matrices, 16 floats apart.
+/// @return The number of entities composed, the caller composes the rest.
+template <typename Lanes>
+size_t ComposeLanes(const size_t count, const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales,
+    const glm::mat4& parent, const glm::mat4& parentNoScale, glm::mat4* locals, glm::mat4* worlds, glm::mat4* worldsNoScale)
+{
+    using Reg = typename Lanes::Reg;
+
+    const Reg zero = Lanes::Broadcast(0.0f);
+    const Reg one = Lanes::Broadcast(1.0f);
+    const Reg two = Lanes::Broadcast(2.0f);
+
+    //the last row of both parents is (0, 0, 0, 1), it is never read
+    const float* const parentData = reinterpret_cast<const float*>(&parent);
+    const float* const parentNoScaleData = reinterpret_cast<const float*>(&parentNoScale);
+    Reg parentElements[4][3];
+    Reg parentNoScaleElements[4][3];
+    for (int column = 0; column < 4; ++column)
+    {
+        for (int row = 0; row < 3; ++row)
+        {
+            parentElements[column][row] = Lanes::Broadcast(parentData[column * 4 + row]);
+            parentNoScaleElements[column][row] = Lanes::Broadcast(parentNoScaleData[column * 4 + row]);
+        }
+    }
+
+    //out = a * b for affine matrices, column by column
+    const auto multiplyAffine = [](const Reg (&a)[4][3], const Reg (&b)[4][3], Reg (&out)[4][3])
+    {
+        for (int column = 0; column < 4; ++column)
+        {
+            for (int row = 0; row < 3; ++row)
+            {
+                out[column][row] = Lanes::Add
+                (
+                    Lanes::Add(Lanes::Mul(a[0][row], b[column][0]), Lanes::Mul(a[1][row], b[column][1])),
+                    Lanes::Mul(a[2][row], b[column][2])
+                );
+            }
+        }
+        for (int row = 0; row < 3; ++row)
+        {
+            out[3][row] = Lanes::Add(out[3][row], a[3][row]);
+        }
+    };
+
+    const auto store = [&](glm::mat4* out, const Reg (&elements)[4][3])
+    {
+        float* const data = reinterpret_cast<float*>(out);
+        for (int column = 0; column < 4; ++column)
+        {
+            Lanes::Store(data + column * 4, elements[column][0], elements[column][1], elements[column][2], column == 3 ? one : zero);
+        }
+    };
+
+    size_t i = 0;
+    for (; i + Lanes::WIDTH <= count; i += Lanes::WIDTH)
+    {
+        const Reg qx = Lanes::Load(&rotations[i].x, 4);
+        const Reg qy = Lanes::Load(&rotations[i].y, 4);
+        const Reg qz = Lanes::Load(&rotations[i].z, 4);
+        const Reg qw = Lanes::Load(&rotations[i].w, 4);
+
+        const Reg xx = Lanes::Mul(qx, qx);
+        const Reg yy = Lanes::Mul(qy, qy);
+        const Reg zz = Lanes::Mul(qz, qz);
+        const Reg xz = Lanes::Mul(qx, qz);
+        const Reg xy = Lanes::Mul(qx, qy);
+        const Reg yz = Lanes::Mul(qy, qz);
+        const Reg wx = Lanes::Mul(qw, qx);
+        const Reg wy = Lanes::Mul(qw, qy);
+        const Reg wz = Lanes::Mul(qw, qz);
+
+        const Reg translation[3] = { Lanes::Load(&positions[i].x, 3), Lanes::Load(&positions[i].y, 3), Lanes::Load(&positions[i].z, 3) };
+        const Reg scale[3] = { Lanes::Load(&scales[i].x, 3), Lanes::Load(&scales[i].y, 3), Lanes::Load(&scales[i].z, 3) };
+
+        const Reg rigid[4][3] =
+        {
+            { Lanes::Sub(one, Lanes::Mul(two, Lanes::Add(yy, zz))), Lanes::Mul(two, Lanes::Add(xy, wz)), Lanes::Mul(two, Lanes::Sub(xz, wy)) },
+            { Lanes::Mul(two, Lanes::Sub(xy, wz)), Lanes::Sub(one, Lanes::Mul(two, Lanes::Add(xx, zz))), Lanes::Mul(two, Lanes::Add(yz, wx)) },
+            { Lanes::Mul(two, Lanes::Add(xz, wy)), Lanes::Mul(two, Lanes::Sub(yz, wx)), Lanes::Sub(one, Lanes::Mul(two, Lanes::Add(xx, yy))) },
+            { translation[0], translation[1], translation[2] }
+        };
+
+        Reg local[4][3];
+        for (int column = 0; column < 3; ++column)
+        {
+            for (int row = 0; row < 3; ++row)
+            {
+                local[column][row] = Lanes::Mul(rigid[column][row], scale[column]);
+            }
+        }
+        for (int row = 0; row < 3; ++row)
+        {
+            local[3][row] = translation[row];
+        }
+
+        Reg world[4][3];
+        Reg worldNoScale[4][3];
+        multiplyAffine(parentElements, local, world);
+        multiplyAffine(parentNoScaleElements, rigid, worldNoScale);
+
+        store(locals + i, local);
+        store(worlds + i, world);
+        store(worldsNoScale + i, worldNoScale);
+    }
+
+    return i;
+}
+
+} // namespace
+
+} // namespace velecs
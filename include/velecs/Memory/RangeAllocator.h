@@ -0,0 +1,77 @@
+/// @file    RangeAllocator.h
+/// @author  Matthew Green
+/// @date    2026-10-17 20:31:09
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+
+namespace velecs {
+
+/// @class RangeAllocator
+/// @brief Free-list allocator handing out [offset, offset + size) ranges of a fixed-size space.
+///
+/// The allocator only does bookkeeping, it never touches memory itself. Free ranges are kept
+/// sorted by offset so neighbouring ranges are coalesced when freed. Allocation is first-fit.
+class RangeAllocator {
+public:
+    // Enums
+
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor. Manages an empty space.
+    RangeAllocator() = default;
+
+    /// @brief Constructor.
+    /// @param[in] capacity The size of the managed space, in allocation units.
+    RangeAllocator(const uint32_t capacity);
+
+    /// @brief Default deconstructor.
+    ~RangeAllocator() = default;
+
+    // Public Methods
+
+    /// @brief Tries to allocate a range.
+    /// @param[in] size The size of the range, in allocation units.
+    /// @param[out] outOffset The offset of the allocated range.
+    /// @return True if a large enough free range was found, false otherwise.
+    bool TryAllocate(const uint32_t size, uint32_t& outOffset);
+
+    /// @brief Returns a previously allocated range to the free list.
+    /// @param[in] offset The offset returned by TryAllocate.
+    /// @param[in] size The size passed to TryAllocate.
+    void Free(const uint32_t offset, const uint32_t size);
+
+    /// @brief Gets the size of the managed space.
+    /// @return The capacity, in allocation units.
+    inline uint32_t GetCapacity() const { return capacity; }
+
+    /// @brief Gets the number of allocated units.
+    /// @return The allocated size, in allocation units.
+    inline uint32_t GetUsed() const { return used; }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    uint32_t capacity{0}; /// @brief Size of the managed space.
+    uint32_t used{0}; /// @brief Number of allocated units.
+    std::map<uint32_t, uint32_t> freeRanges; /// @brief Free ranges, offset to size, sorted by offset.
+
+    // Private Methods
+};
+
+} // namespace velecs
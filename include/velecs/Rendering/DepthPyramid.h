@@ -0,0 +1,135 @@
+/// @file    DepthPyramid.h
+/// @author  Matthew Green
+/// @date    2026-10-18 03:06:14
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Memory/AllocatedImage.h"
+#include "velecs/Memory/DeletionQueue.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <array>
+#include <cstdint>
+
+namespace velecs {
+
+/// @class DepthPyramid
+/// @brief Mip chain of a depth image where every texel holds the farthest depth of the texels below it.
+///
+/// Level 0 is half the size of the depth image, every following level halves the previous one down to 1x1.
+/// Odd sizes round up and the last row and column fold in the extra texels, so every texel stays a
+/// conservative bound of the screen area it covers. An object whose nearest depth is farther than the
+/// pyramid over its screen bounds is hidden behind what was rendered.
+class DepthPyramid {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t MAX_LEVELS = 16; /// @brief Enough levels for a 65536 pixel wide depth image.
+    static constexpr uint32_t WORKGROUP_SIZE = 8; /// @brief local_size_x and local_size_y of the reduction shader.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    DepthPyramid() = default;
+
+    /// @brief Default deconstructor.
+    ~DepthPyramid() = default;
+
+    // Public Methods
+
+    /// @brief Creates the sampler, the descriptor set layouts and the reduction pipeline.
+    /// @param[in] device The device the pyramid is built on.
+    /// @param[in] allocator The allocator the pyramid image is created with.
+    /// @param[in] pipelineCache The cache the reduction pipeline is created with, or VK_NULL_HANDLE.
+    /// @throws std::runtime_error if a Vulkan object cannot be created.
+    void Init(VkDevice device, VmaAllocator allocator, VkPipelineCache pipelineCache = VK_NULL_HANDLE);
+
+    /// @brief Destroys every resource, including the pyramid image.
+    void Cleanup();
+
+    /// @brief Creates the pyramid image and descriptor sets for a depth image, retiring the previous ones.
+    /// @param[in] depthImageView The view of the depth image the pyramid is built from. It needs the sampled usage.
+    /// @param[in] depthExtent The size of the depth image.
+    /// @param[in,out] retired The deletion queue the previous resources are pushed to, flushed once no frame uses them.
+    /// @throws std::runtime_error if a Vulkan object cannot be created.
+    void Resize(VkImageView depthImageView, const VkExtent2D depthExtent, DeletionQueue& retired);
+
+    /// @brief Records the reduction of the depth image into the pyramid. Must be called outside of a render pass.
+    ///
+    /// The depth image is expected in VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, as the main render pass
+    /// leaves it, and is returned to it afterwards. Without depth to reduce the pyramid is only made readable.
+    /// @param[in] cmd The command buffer to record into.
+    /// @param[in] depthImage The depth image, holding the previous frame's depth.
+    /// @param[in] hasDepth False if the depth image was never rendered into since it was created.
+    /// @return True if the pyramid holds the depth image's content.
+    bool Build(VkCommandBuffer cmd, VkImage depthImage, const bool hasDepth);
+
+    /// @brief Gets the layout of the set the culling shader samples the pyramid through.
+    /// @return A layout with the pyramid as a combined image sampler at binding 0.
+    inline VkDescriptorSetLayout GetSetLayout() const { return sampleSetLayout; }
+
+    /// @brief Gets the set the culling shader samples the pyramid through.
+    /// @return The set, VK_NULL_HANDLE before Resize.
+    inline VkDescriptorSet GetSet() const { return sampleSet; }
+
+    /// @brief Gets the size of the depth image the pyramid is built from.
+    /// @return The extent passed to Resize.
+    inline VkExtent2D GetDepthExtent() const { return depthExtent; }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    /// @struct ReduceConstants
+    /// @brief Push constants of the reduction shader.
+    struct ReduceConstants {
+        int32_t sourceWidth;
+        int32_t sourceHeight;
+        int32_t destinationWidth;
+        int32_t destinationHeight;
+    };
+
+    VkDevice device{VK_NULL_HANDLE};
+    VmaAllocator allocator{nullptr};
+
+    VkSampler sampler{VK_NULL_HANDLE};
+    VkDescriptorSetLayout reduceSetLayout{VK_NULL_HANDLE};
+    VkDescriptorSetLayout sampleSetLayout{VK_NULL_HANDLE};
+    VkPipelineLayout reducePipelineLayout{VK_NULL_HANDLE};
+    VkPipeline reducePipeline{VK_NULL_HANDLE};
+
+    VkExtent2D depthExtent{0, 0};
+    uint32_t levelCount{0};
+    std::array<VkExtent2D, MAX_LEVELS> levelExtents{};
+
+    AllocatedImage image; /// @brief R32_SFLOAT image with levelCount mips.
+    VkImageView sampleView{VK_NULL_HANDLE}; /// @brief View of every level, read by the culling shader.
+    std::array<VkImageView, MAX_LEVELS> levelViews{}; /// @brief View of every single level, written by the reduction.
+
+    VkDescriptorPool descriptorPool{VK_NULL_HANDLE}; /// @brief Pool of the size dependent sets, replaced by Resize.
+    std::array<VkDescriptorSet, MAX_LEVELS> reduceSets{}; /// @brief Source and destination of every reduction step.
+    VkDescriptorSet sampleSet{VK_NULL_HANDLE};
+
+    // Private Methods
+
+    /// @brief Pushes the size dependent resources to a deletion queue and forgets them.
+    /// @param[in,out] retired The deletion queue to push to.
+    void Retire(DeletionQueue& retired);
+};
+
+} // namespace velecs
@@ -0,0 +1,76 @@
+/// @file    FrameData.h
+/// @author  Matthew Green
+/// @date    2026-10-17 19:07:40
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Memory/DeletionQueue.h"
+#include "velecs/Memory/AllocatedBuffer.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <vector>
+
+namespace velecs {
+
+/// @struct FrameData
+/// @brief Per-frame rendering context.
+///
+/// Every frame in flight owns its own command pool, command buffer, synchronization
+/// primitives and deletion queue, so the CPU can record frame N+1 while the GPU is
+/// still executing frame N.
+struct FrameData {
+public:
+    // Enums
+
+    // Public Fields
+
+    VkCommandPool _commandPool{VK_NULL_HANDLE}; /// @brief Pool the frame's command buffers are allocated from.
+    VkCommandBuffer _mainCommandBuffer{VK_NULL_HANDLE}; /// @brief Command buffer recording this frame's rendering commands.
+    VkCommandBuffer _inlineCommandBuffer{VK_NULL_HANDLE}; /// @brief Secondary command buffer recorded on the main thread inside the main render pass.
+
+    std::vector<VkCommandPool> _recordingCommandPools; /// @brief One pool per recording thread, reset as a whole every frame.
+    std::vector<VkCommandBuffer> _recordingCommandBuffers; /// @brief Secondary command buffer of every recording pool.
+
+    VkSemaphore _presentSemaphore{VK_NULL_HANDLE}; /// @brief Signaled when the acquired swapchain image is ready.
+    VkSemaphore _renderSemaphore{VK_NULL_HANDLE}; /// @brief Signaled when rendering has finished and the image can be presented.
+    VkFence _renderFence{VK_NULL_HANDLE}; /// @brief Signaled when the GPU has finished executing this frame.
+
+    AllocatedBuffer _instanceBuffer; /// @brief Host-visible buffer holding this frame's InstanceData.
+    void* _instanceBufferMapped{nullptr}; /// @brief Persistent mapping of _instanceBuffer.
+    uint32_t _instanceCapacity{0}; /// @brief Number of InstanceData elements _instanceBuffer can hold.
+
+    AllocatedBuffer _cameraBuffer; /// @brief Host-visible uniform buffer holding this frame's CameraData.
+    void* _cameraBufferMapped{nullptr}; /// @brief Persistent mapping of _cameraBuffer.
+    VkDescriptorSet _cameraDescriptorSet{VK_NULL_HANDLE}; /// @brief Set pointing at _cameraBuffer.
+
+    DeletionQueue _deletionQueue; /// @brief Resources to release once this frame's fence has been signaled again.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    FrameData() = default;
+
+    /// @brief Default deconstructor.
+    ~FrameData() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
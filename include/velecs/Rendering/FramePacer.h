@@ -0,0 +1,96 @@
+/// @file    FramePacer.h
+/// @author  Matthew Green
+/// @date    2026-10-18 02:27:53
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace velecs {
+
+/// @class FramePacer
+/// @brief Measures input-to-present latency and delays input sampling so frames finish just in time.
+///
+/// The latency of a frame is the time from its input being sampled to its rendering being observed
+/// as complete, the point where its image is handed over to the presentation engine. The interval
+/// between completions is the rate frames are presented at. Sampling input at the expected completion
+/// of the next frame minus the measured latency leaves no time for the input to go stale while the frame
+/// waits to be presented.
+class FramePacer {
+public:
+    // Enums
+
+    // Public Fields
+
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr float SMOOTHING = 0.1f; /// @brief Weight of a new sample in the moving averages.
+    static constexpr float SAFETY_MARGIN_MS = 1.0f; /// @brief Slack left between the expected completion and the deadline.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    FramePacer() = default;
+
+    /// @brief Default deconstructor.
+    ~FramePacer() = default;
+
+    // Public Methods
+
+    /// @brief Sizes the ring of input timestamps.
+    /// @param[in] framesInFlight The number of frames in flight. One more frame can be sampled while the oldest is still measured.
+    void Init(const uint32_t framesInFlight);
+
+    /// @brief Sleeps until the latest moment input can be sampled for the next frame to complete on time.
+    ///
+    /// Returns immediately until enough frames have been measured, or if the frames take longer than
+    /// the present interval.
+    void WaitForInputSample() const;
+
+    /// @brief Records when the input of a frame was sampled.
+    /// @param[in] frameNumber The number of the frame the input is for.
+    void OnInputSampled(const uint32_t frameNumber);
+
+    /// @brief Records that a frame's rendering was observed as complete. Only the first call after OnInputSampled counts.
+    /// @param[in] frameNumber The number of the completed frame.
+    void OnFrameCompleted(const uint32_t frameNumber);
+
+    /// @brief Gets the averaged time from input sampling to the frame being ready to present.
+    /// @return The latency in milliseconds, 0 until a frame was measured.
+    inline float GetInputToPresentMs() const { return latencyMs; }
+
+    /// @brief Gets the averaged time between two frames becoming ready to present.
+    /// @return The interval in milliseconds, 0 until two frames were measured.
+    inline float GetPresentIntervalMs() const { return intervalMs; }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    std::vector<Clock::time_point> inputSampleTimes; /// @brief Input sample time of the frames not measured yet, indexed by frame number.
+    Clock::time_point lastCompletion; /// @brief When the last frame was observed as complete.
+    float latencyMs{0.0f};
+    float intervalMs{0.0f};
+
+    // Private Methods
+
+    /// @brief Blends a sample into a moving average.
+    /// @param[in] average The current average, 0 if there is none yet.
+    /// @param[in] sample The new sample.
+    /// @return The new average.
+    static float Smooth(const float average, const float sample);
+};
+
+} // namespace velecs
@@ -0,0 +1,275 @@
+/// @file    GPUCullingPass.h
+/// @author  Matthew Green
+/// @date    2026-10-17 23:18:05
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Memory/AllocatedBuffer.h"
+
+#include "velecs/Rendering/MeshRange.h"
+#include "velecs/Rendering/RenderStats.h"
+#include "velecs/Rendering/DepthPyramid.h"
+
+#include "velecs/Math/Bounds.h"
+#include "velecs/Math/Frustum.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace velecs {
+
+struct SimpleMesh;
+class MeshArena;
+
+/// @class GPUCullingPass
+/// @brief GPU-driven rendering path culling objects in a compute shader and drawing them indirectly.
+///
+/// Every frame the transforms and bounds of the objects are written into a storage buffer.
+/// A first compute dispatch tests every object against the camera frustum and appends the visible
+/// ones to the instance list of their batch (one batch per pipeline and mesh level of detail). A second
+/// dispatch turns the batches into VkDrawIndexedIndirectCommands, compacted per pipeline when
+/// vkCmdDrawIndexedIndirectCount is available. The main pass then records one indirect draw per pipeline, whatever the object count.
+///
+/// With a DepthPyramid, the culling dispatch also skips the objects hidden behind the previous frame's depth.
+class GPUCullingPass {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t WORKGROUP_SIZE = 64; /// @brief local_size_x of the culling compute shaders.
+    static constexpr uint32_t MAX_PIPELINES = 64; /// @brief Number of distinct pipeline and index type pairs drawable in one frame.
+
+    /// @struct ObjectData
+    /// @brief Per-object data read by the culling and the indirect vertex shaders. Matches ObjectData in the shaders (std430).
+    struct ObjectData {
+        glm::mat4 world; /// @brief Local to world matrix.
+        glm::vec4 color; /// @brief Color of the object's material.
+        glm::vec4 boundingSphere; /// @brief Local space bounding sphere, center in xyz and radius in w.
+        uint32_t batchIndex; /// @brief Batch the object is drawn with.
+        uint32_t _padding[3];
+    };
+
+    /// @struct DrawBatch
+    /// @brief Objects sharing a pipeline and a mesh. Matches DrawBatch in the shaders (std430).
+    struct DrawBatch {
+        uint32_t indexCount; /// @brief Number of indices of the mesh.
+        uint32_t firstIndex; /// @brief First index of the mesh in the arena.
+        int32_t vertexOffset; /// @brief Offset added to every index of the mesh.
+        uint32_t firstInstance; /// @brief First slot of the batch in the visible object list.
+        uint32_t instanceCount; /// @brief Visible objects, incremented by the culling shader.
+        uint32_t pipelineIndex; /// @brief Index of the pipeline the batch is drawn with.
+        uint32_t pipelineFirstCommand; /// @brief First draw command of the batch's pipeline.
+        uint32_t commandIndex; /// @brief Draw command of the batch when commands are not compacted.
+    };
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    GPUCullingPass() = default;
+
+    /// @brief Default deconstructor.
+    ~GPUCullingPass() = default;
+
+    // Public Methods
+
+    /// @brief Creates the descriptor sets, the pipeline layouts and the compute pipelines.
+    /// @param[in] device The device the pass records on.
+    /// @param[in] allocator The allocator the per-frame buffers are created with.
+    /// @param[in] framesInFlight The number of per-frame resource sets to create.
+    /// @param[in] drawIndexedIndirectCount vkCmdDrawIndexedIndirectCount, or nullptr when the device does not support it.
+    /// @param[in] multiDrawIndirect True if the multiDrawIndirect feature is enabled.
+    /// @param[in] cameraSetLayout The layout of the per-frame CameraData set, bound at set 1 by the indirect pipelines.
+    /// @param[in] depthPyramidSetLayout The layout of the DepthPyramid set to enable occlusion culling, or VK_NULL_HANDLE.
+    /// @param[in] pipelineCache The cache the compute pipelines are created with, or VK_NULL_HANDLE.
+    /// @throws std::runtime_error if a Vulkan object cannot be created.
+    void Init
+    (
+        VkDevice device,
+        VmaAllocator allocator,
+        const uint32_t framesInFlight,
+        PFN_vkCmdDrawIndexedIndirectCount drawIndexedIndirectCount,
+        const bool multiDrawIndirect,
+        VkDescriptorSetLayout cameraSetLayout,
+        VkDescriptorSetLayout depthPyramidSetLayout,
+        VkPipelineCache pipelineCache = VK_NULL_HANDLE
+    );
+
+    /// @brief Destroys every resource created by Init and the per-frame buffers.
+    void Cleanup();
+
+    /// @brief Gets the pipeline layout the indirect graphics pipelines have to be created with.
+    /// @return A pointer to the layout, suitable for Material::Create.
+    inline VkPipelineLayout* GetDrawPipelineLayout() { return &drawPipelineLayout; }
+
+    /// @brief Starts gathering the objects of a frame.
+    /// @param[in] frameIndex The index of the frame's resources, below framesInFlight.
+    void BeginFrame(const uint32_t frameIndex);
+
+    /// @brief Finds or creates the batch of a pipeline and mesh level of detail for the current frame.
+    /// @param[in] pipeline The indirect pipeline the mesh is drawn with.
+    /// @param[in] mesh The mesh. Its data must already be uploaded.
+    /// @param[in] lod The level of detail of the mesh, below its GetLODCount.
+    /// @return The index of the batch, to pass to AddObject.
+    /// @throws std::runtime_error if more than MAX_PIPELINES pipelines are used in the frame.
+    uint32_t GetBatch(const VkPipeline pipeline, const SimpleMesh& mesh, const uint32_t lod = 0);
+
+    /// @brief Makes room for count more objects, so they can be added without reallocating.
+    /// @param[in] count The number of objects about to be added.
+    void ReserveObjects(const uint32_t count);
+
+    /// @brief Adds an object to the current frame.
+    /// @param[in] batchIndex The batch returned by GetBatch.
+    /// @param[in] world The object's local to world matrix.
+    /// @param[in] color The object's color.
+    /// @param[in] boundingSphere The local space bounding sphere of the object's mesh.
+    void AddObject(const uint32_t batchIndex, const glm::mat4& world, const glm::vec4& color, const BoundingSphere& boundingSphere);
+
+    /// @brief Records the culling and draw generation dispatches. Must be called outside of a render pass.
+    /// @param[in] cmd The command buffer of the current frame.
+    /// @param[in] frustum The world space frustum of the camera.
+    /// @param[in] cameraSet The descriptor set holding the frame's CameraData, read by the occlusion test.
+    /// @param[in] depthPyramid The pyramid built this frame. Required when occlusion culling is enabled, its set is bound either way.
+    /// @param[in] testOcclusion True if the pyramid holds depth to cull against, false to only cull against the frustum.
+    void RecordCulling(VkCommandBuffer cmd, const Frustum& frustum, VkDescriptorSet cameraSet, const DepthPyramid* depthPyramid, const bool testOcclusion);
+
+    /// @brief Checks whether the culling dispatch was created with the occlusion test.
+    /// @return True if a depth pyramid set layout was passed to Init.
+    inline bool IsOcclusionEnabled() const { return occlusionEnabled; }
+
+    /// @brief Records the indirect draws of every pipeline used in the frame.
+    /// @param[in] cmd The command buffer of the current frame, inside the main render pass, with the mesh arena bound.
+    /// @param[in] cameraSet The descriptor set holding the frame's CameraData.
+    /// @param[in] meshArena The bound mesh arena, its index buffer is rebound for 16-bit meshes and restored afterwards.
+    /// @param[in,out] stats The counters to add the recorded binds and draws to.
+    void RecordDraws(VkCommandBuffer cmd, VkDescriptorSet cameraSet, const MeshArena& meshArena, RenderStats& stats) const;
+
+    /// @brief Gets the number of objects added to the current frame.
+    /// @return The object count.
+    inline uint32_t GetObjectCount() const { return objectCount; }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    /// @struct FrameResources
+    /// @brief Buffers and descriptor set owned by one frame in flight.
+    struct FrameResources {
+        AllocatedBuffer objectBuffer; /// @brief Host-visible ObjectData array.
+        ObjectData* mappedObjects{nullptr};
+        uint32_t objectCapacity{0};
+
+        AllocatedBuffer batchBuffer; /// @brief Host-visible DrawBatch array, its instance counts are written by the GPU.
+        DrawBatch* mappedBatches{nullptr};
+        uint32_t batchCapacity{0};
+
+        AllocatedBuffer visibleBuffer; /// @brief Indices of the visible objects, grouped by batch.
+        uint32_t visibleCapacity{0};
+
+        AllocatedBuffer commandBuffer; /// @brief VkDrawIndexedIndirectCommands generated by the GPU.
+        uint32_t commandCapacity{0};
+
+        AllocatedBuffer countBuffer; /// @brief Number of compacted commands of every pipeline.
+
+        VkDescriptorSet descriptorSet{VK_NULL_HANDLE};
+    };
+
+    /// @struct PipelineBatches
+    /// @brief Batches drawn with the same pipeline and index type during the current frame.
+    struct PipelineBatches {
+        VkPipeline pipeline{VK_NULL_HANDLE};
+        VkIndexType indexType{VK_INDEX_TYPE_UINT32}; /// @brief Index type of every mesh of the batches, one indirect draw cannot mix them.
+        std::unordered_map<uint32_t, uint32_t> batches; /// @brief Batch index of every mesh level, keyed by its first index in the arena.
+        uint32_t firstCommand{0}; /// @brief First draw command of the pipeline, assigned by RecordCulling.
+    };
+
+    /// @struct BatchInfo
+    /// @brief CPU side description of a batch, turned into a DrawBatch by RecordCulling.
+    struct BatchInfo {
+        MeshRange range;
+        uint32_t pipelineIndex{0};
+        uint32_t objectCount{0};
+    };
+
+    /// @struct CullConstants
+    /// @brief Push constants of the compute shaders.
+    struct CullConstants {
+        glm::vec4 frustumPlanes[Frustum::Plane::Count];
+        uint32_t count;
+        uint32_t compact;
+        uint32_t occlusion;
+        float depthWidth;
+        float depthHeight;
+    };
+
+    VkDevice device{VK_NULL_HANDLE};
+    VmaAllocator allocator{nullptr};
+
+    PFN_vkCmdDrawIndexedIndirectCount drawIndexedIndirectCount{nullptr};
+    bool multiDrawIndirect{false};
+    bool occlusionEnabled{false};
+
+    VkDescriptorSetLayout descriptorSetLayout{VK_NULL_HANDLE};
+    VkDescriptorPool descriptorPool{VK_NULL_HANDLE};
+
+    VkPipelineLayout cullPipelineLayout{VK_NULL_HANDLE};
+    VkPipeline cullPipeline{VK_NULL_HANDLE};
+    VkPipeline buildDrawsPipeline{VK_NULL_HANDLE};
+
+    VkPipelineLayout drawPipelineLayout{VK_NULL_HANDLE};
+
+    std::vector<FrameResources> frames;
+    uint32_t currentFrame{0};
+
+    std::vector<PipelineBatches> pipelines;
+    std::vector<BatchInfo> batches;
+    uint32_t objectCount{0};
+
+    // Private Methods
+
+    /// @brief Creates a buffer, persistently mapped when hostVisible is true.
+    /// @param[in] size The size of the buffer in bytes.
+    /// @param[in] usage The usage flags of the buffer.
+    /// @param[in] hostVisible True to create a mapped, host-visible buffer, false for device local memory.
+    /// @param[out] outMapped The mapping when hostVisible is true.
+    /// @return The buffer.
+    /// @throws std::runtime_error if the buffer cannot be created.
+    AllocatedBuffer CreateBuffer(const VkDeviceSize size, const VkBufferUsageFlags usage, const bool hostVisible, void** outMapped = nullptr) const;
+
+    /// @brief Destroys a buffer if it was created.
+    /// @param[in,out] buffer The buffer to destroy, reset afterwards.
+    void DestroyBuffer(AllocatedBuffer& buffer) const;
+
+    /// @brief Grows a frame's GPU written buffers so they can hold the current frame's objects and batches.
+    /// @param[in,out] frame The frame owning the buffers.
+    void ReserveGPUBuffers(FrameResources& frame);
+
+    /// @brief Points the frame's descriptor set at its current buffers.
+    /// @param[in] frame The frame owning the descriptor set.
+    void UpdateDescriptorSet(const FrameResources& frame) const;
+
+    /// @brief Computes the capacity to grow to, doubling from the current one.
+    /// @param[in] current The current capacity.
+    /// @param[in] required The number of elements required.
+    /// @return The new capacity.
+    static uint32_t GrowCapacity(const uint32_t current, const uint32_t required);
+};
+
+} // namespace velecs
@@ -0,0 +1,170 @@
+/// @file    GPUProfiler.h
+/// @author  Matthew Green
+/// @date    2026-10-18 01:41:26
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace velecs {
+
+/// @class GPUProfiler
+/// @brief Measures the GPU time of named scopes with timestamp queries.
+///
+/// Every frame in flight owns a query pool. Scopes write a timestamp when they begin and when they end,
+/// and the results of a frame are read back the next time its pool is reused, once its fence has been
+/// waited on, so reading them never stalls. Scopes sharing a name within a frame are summed, then every
+/// name keeps a short history its average is computed from.
+class GPUProfiler {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t HISTORY_SIZE = 120; /// @brief Number of frames the timings are averaged over.
+    static constexpr uint32_t INVALID_SCOPE = UINT32_MAX; /// @brief Returned by BeginScope when nothing is measured.
+
+    /// @struct PassTiming
+    /// @brief GPU time of every scope sharing a name.
+    struct PassTiming {
+        std::string name; /// @brief Name the scopes were begun with.
+        float lastMs{0.0f}; /// @brief Time of the last frame read back, in milliseconds.
+        float averageMs{0.0f}; /// @brief Average over the history, in milliseconds.
+        float maxMs{0.0f}; /// @brief Maximum over the history, in milliseconds.
+        std::array<float, HISTORY_SIZE> history{}; /// @brief Ring of the last timings, oldest at historyOffset once full.
+        uint32_t historyOffset{0}; /// @brief Slot the next timing is written to.
+        uint32_t historyCount{0}; /// @brief Number of valid timings in history.
+    };
+
+    /// @class Scope
+    /// @brief Measures the commands recorded into a command buffer during its lifetime.
+    class Scope {
+    public:
+        /// @brief Begins the scope.
+        /// @param[in] profiler The profiler to measure with.
+        /// @param[in] cmd The command buffer the scope is recorded into.
+        /// @param[in] name The name of the scope, it must outlive the frame's readback.
+        Scope(GPUProfiler& profiler, VkCommandBuffer cmd, const char* name);
+
+        /// @brief Ends the scope.
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        GPUProfiler& profiler;
+        VkCommandBuffer cmd;
+        uint32_t scope;
+    };
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    GPUProfiler() = default;
+
+    /// @brief Default deconstructor.
+    ~GPUProfiler() = default;
+
+    // Public Methods
+
+    /// @brief Creates one query pool per frame in flight.
+    /// @param[in] device The device the queries are recorded on.
+    /// @param[in] physicalDevice The physical device the timestamp period is read from.
+    /// @param[in] queueFamily The queue family the measured command buffers are submitted to.
+    /// @param[in] framesInFlight The number of query pools to create.
+    /// @param[in] maxScopes The number of scopes a single frame can measure.
+    /// @throws std::runtime_error if a query pool cannot be created.
+    void Init(VkDevice device, VkPhysicalDevice physicalDevice, const uint32_t queueFamily, const uint32_t framesInFlight, const uint32_t maxScopes = 256);
+
+    /// @brief Destroys the query pools.
+    void Cleanup();
+
+    /// @brief Checks whether the queue family supports timestamps. Every call is a no-op otherwise.
+    /// @return True if scopes are measured.
+    inline bool IsSupported() const { return timestampValidBits != 0; }
+
+    /// @brief Reads back the results of the frame's previous use and resets its query pool.
+    /// @param[in] cmd The primary command buffer of the frame, outside of a render pass.
+    /// @param[in] frameIndex The index of the frame, below framesInFlight. Its fence must have been waited on.
+    void BeginFrame(VkCommandBuffer cmd, const uint32_t frameIndex);
+
+    /// @brief Writes the timestamp beginning a scope. Safe to call from several recording threads.
+    /// @param[in] cmd The command buffer the scope is recorded into.
+    /// @param[in] name The name of the scope, it must outlive the frame's readback.
+    /// @return The scope to pass to EndScope, INVALID_SCOPE if timestamps are not supported or the frame is full.
+    uint32_t BeginScope(VkCommandBuffer cmd, const char* name);
+
+    /// @brief Writes the timestamp ending a scope. Every scope has to be ended before the frame is submitted.
+    /// @param[in] cmd The command buffer the scope is recorded into.
+    /// @param[in] scope The scope returned by BeginScope.
+    void EndScope(VkCommandBuffer cmd, const uint32_t scope);
+
+    /// @brief Gets the timings of every scope name seen so far, in the order they first appeared.
+    /// @return The timings.
+    inline const std::vector<PassTiming>& GetPassTimings() const { return passes; }
+
+    /// @brief Gets the timing of a scope name.
+    /// @param[in] name The name of the scope.
+    /// @return The timing, or nullptr if no scope with this name has been read back yet.
+    const PassTiming* FindPassTiming(const std::string& name) const;
+
+    /// @brief Writes the average, last and maximum time of every scope name.
+    /// @param[in,out] stream The stream to write to.
+    void Log(std::ostream& stream) const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    /// @struct FrameQueries
+    /// @brief Query pool and scope names of one frame in flight.
+    struct FrameQueries {
+        VkQueryPool pool{VK_NULL_HANDLE};
+        std::vector<const char*> names; /// @brief Name of every scope begun during the frame.
+        uint32_t scopeCount{0}; /// @brief Scopes measured during the frame's last use.
+    };
+
+    VkDevice device{VK_NULL_HANDLE};
+    float timestampPeriod{1.0f}; /// @brief Nanoseconds per timestamp tick.
+    uint32_t timestampValidBits{0};
+    uint32_t maxScopes{0};
+
+    std::vector<FrameQueries> frames;
+    FrameQueries* currentFrame{nullptr};
+    std::atomic<uint32_t> nextScope{0};
+
+    std::vector<uint64_t> results; /// @brief Scratch buffer the timestamps are read into.
+    std::vector<float> frameTotals; /// @brief Scratch buffer summing the scopes of a frame per pass.
+    std::vector<PassTiming> passes;
+
+    // Private Methods
+
+    /// @brief Reads the timestamps of a frame and adds them to the history of their pass.
+    /// @param[in] frame The frame to read.
+    void ReadResults(const FrameQueries& frame);
+
+    /// @brief Finds or creates the timing of a scope name.
+    /// @param[in] name The name of the scope.
+    /// @return The index of the timing in passes.
+    uint32_t GetPassIndex(const char* name);
+};
+
+} // namespace velecs
@@ -0,0 +1,62 @@
+/// @file    InstanceData.h
+/// @author  Matthew Green
+/// @date    2026-10-17 19:42:18
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Rendering/VertexInputAttributeDescriptor.h"
+
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+namespace velecs {
+
+/// @struct InstanceData
+/// @brief Per-instance data streamed to the instanced shaders through a second vertex binding.
+///
+/// One InstanceData is written per entity into the current frame's instance buffer,
+/// which is then bound at binding 1 with an instance input rate.
+struct InstanceData {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t BINDING = 1; /// @brief Vertex binding the instance buffer is bound to.
+    static constexpr uint32_t FIRST_LOCATION = 1; /// @brief First shader input location used by the instance attributes.
+
+    glm::mat4 modelMatrix; /// @brief Local to world matrix of the instance.
+    glm::vec4 color; /// @brief Color of the instance's material.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    InstanceData() = default;
+
+    /// @brief Default deconstructor.
+    ~InstanceData() = default;
+
+    // Public Methods
+
+    /// @brief Appends the instance binding and attributes to an existing vertex description.
+    /// @param[in,out] description The per-vertex description to extend.
+    static void AppendVertexDescription(VertexInputAttributeDescriptor& description);
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -0,0 +1,144 @@
+/// @file    MeshArena.h
+/// @author  Matthew Green
+/// @date    2026-10-17 20:41:55
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Memory/AllocatedBuffer.h"
+#include "velecs/Memory/RangeAllocator.h"
+#include "velecs/Rendering/MeshRange.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <vector>
+
+namespace velecs {
+
+/// @class MeshArena
+/// @brief One device-local vertex buffer and one index buffer shared by every mesh.
+///
+/// Meshes are suballocated out of the two buffers and referenced through a MeshRange,
+/// so the buffers only need to be bound once per command buffer. 16-bit and 32-bit indices
+/// share the index buffer, drawing a mesh only requires rebinding it with the mesh's index type.
+class MeshArena {
+public:
+    // Enums
+
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    MeshArena() = default;
+
+    /// @brief Default deconstructor.
+    ~MeshArena() = default;
+
+    // Public Methods
+
+    /// @brief Creates the vertex and index buffers.
+    /// @param[in] allocator The allocator the buffers are created with.
+    /// @param[in] vertexStride The size of one vertex, in bytes.
+    /// @param[in] vertexCapacity The number of vertices the arena can hold.
+    /// @param[in] indexCapacity The number of 32-bit indices the arena can hold, twice as many 16-bit ones.
+    /// @param[in] queueFamilies The queue families accessing the buffers. The buffers are shared concurrently when more than one is given.
+    void Init
+    (
+        VmaAllocator allocator,
+        const uint32_t vertexStride,
+        const uint32_t vertexCapacity,
+        const uint32_t indexCapacity,
+        const std::vector<uint32_t>& queueFamilies
+    );
+
+    /// @brief Destroys the vertex and index buffers. Every MeshRange becomes invalid.
+    void Cleanup();
+
+    /// @brief Tries to reserve space for a mesh.
+    /// @param[in] vertexCount The number of vertices of the mesh.
+    /// @param[in] indexCount The number of indices of the mesh.
+    /// @param[in] indexType The size of the mesh's indices, VK_INDEX_TYPE_UINT16 or VK_INDEX_TYPE_UINT32.
+    /// @param[out] outRange The range reserved for the mesh, left untouched on failure.
+    /// @return True if the space was reserved, false if the arena has no free range large enough.
+    bool TryAllocate(const uint32_t vertexCount, const uint32_t indexCount, const VkIndexType indexType, MeshRange& outRange);
+
+    /// @brief Releases the space reserved for a mesh.
+    /// @param[in] range The range returned by Allocate.
+    /// @note The caller is responsible for making sure the GPU no longer reads the range.
+    void Free(const MeshRange& range);
+
+    /// @brief Binds the vertex buffer at binding 0 and the index buffer with 32-bit indices.
+    /// @param[in] cmd The command buffer to record the binds into.
+    void Bind(VkCommandBuffer cmd) const;
+
+    /// @brief Rebinds the index buffer to draw the meshes of another index type.
+    /// @param[in] cmd The command buffer to record the bind into.
+    /// @param[in] indexType The index type of the meshes drawn next.
+    void BindIndexBuffer(VkCommandBuffer cmd, const VkIndexType indexType) const;
+
+    /// @brief Gets the byte offset of a range inside the vertex buffer.
+    /// @param[in] range The range to locate.
+    /// @return The byte offset of the range's first vertex.
+    inline VkDeviceSize GetVertexByteOffset(const MeshRange& range) const { return (VkDeviceSize)range.vertexOffset * vertexStride; }
+
+    /// @brief Gets the byte offset of a range inside the index buffer.
+    /// @param[in] range The range to locate.
+    /// @return The byte offset of the range's first index.
+    inline VkDeviceSize GetIndexByteOffset(const MeshRange& range) const { return (VkDeviceSize)range.firstIndex * GetIndexSize(range.indexType); }
+
+    /// @brief Gets the size of an index.
+    /// @param[in] indexType VK_INDEX_TYPE_UINT16 or VK_INDEX_TYPE_UINT32.
+    /// @return The size in bytes.
+    static inline uint32_t GetIndexSize(const VkIndexType indexType) { return indexType == VK_INDEX_TYPE_UINT16 ? 2 : 4; }
+
+    /// @brief Gets the buffer holding every mesh's vertices.
+    /// @return The vertex buffer.
+    inline VkBuffer GetVertexBuffer() const { return vertexBuffer._buffer; }
+
+    /// @brief Gets the buffer holding every mesh's indices.
+    /// @return The index buffer.
+    inline VkBuffer GetIndexBuffer() const { return indexBuffer._buffer; }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    VmaAllocator allocator{nullptr}; /// @brief Allocator the buffers were created with.
+
+    uint32_t vertexStride{0}; /// @brief Size of one vertex, in bytes.
+
+    AllocatedBuffer vertexBuffer; /// @brief Device-local buffer holding every mesh's vertices.
+    AllocatedBuffer indexBuffer; /// @brief Device-local buffer holding every mesh's indices.
+
+    RangeAllocator vertexRanges; /// @brief Bookkeeping of vertexBuffer, in vertices.
+    RangeAllocator indexRanges; /// @brief Bookkeeping of indexBuffer, in 16-bit units. Every range spans an even number of them.
+
+    // Private Methods
+
+    /// @brief Gets the number of 16-bit units the indices of a mesh take up.
+    /// @param[in] indexCount The number of indices of the mesh.
+    /// @param[in] indexType The size of the mesh's indices.
+    /// @return An even number of units, so 32-bit indices always start 4-byte aligned.
+    static uint32_t GetIndexUnits(const uint32_t indexCount, const VkIndexType indexType);
+
+    /// @brief Creates a device-local buffer that can be copied into.
+    /// @param[in] size The size of the buffer, in bytes.
+    /// @param[in] usage The usage of the buffer, in addition to being a transfer destination.
+    /// @param[in] queueFamilies The queue families accessing the buffer.
+    /// @return The created buffer.
+    AllocatedBuffer CreateBuffer(const VkDeviceSize size, const VkBufferUsageFlags usage, const std::vector<uint32_t>& queueFamilies) const;
+};
+
+} // namespace velecs
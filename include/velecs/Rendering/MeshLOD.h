@@ -0,0 +1,53 @@
+/// @file    MeshLOD.h
+/// @author  Matthew Green
+/// @date    2026-10-18 04:12:37
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct MeshLOD
+/// @brief Level of detail of a SimpleMesh, a slice of its index list.
+///
+/// Every level reuses the mesh's vertices, only the triangles differ. The offsets are relative
+/// to the mesh's own indices, add them to the MeshRange to draw the level from the MeshArena.
+struct MeshLOD {
+public:
+    // Enums
+
+    // Public Fields
+
+    uint32_t firstIndex{0}; /// @brief First index of the level in the mesh's index list.
+    uint32_t indexCount{0}; /// @brief Number of indices of the level.
+    float error{0.0f}; /// @brief Local space distance the level may deviate from the full detail mesh by.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    MeshLOD() = default;
+
+    /// @brief Default deconstructor.
+    ~MeshLOD() = default;
+
+    // Public Methods
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -26,7 +26,7 @@ public:
     // Public Fields
 
     glm::vec4 color;
-    glm::mat4 renderMatrix;
+    glm::mat4 modelMatrix; /// @brief Local to world matrix, the shaders multiply it by CameraData::viewProjection.
 
     // Constructors and Destructors
     
@@ -0,0 +1,61 @@
+/// @file    MeshRange.h
+/// @author  Matthew Green
+/// @date    2026-10-17 20:38:20
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct MeshRange
+/// @brief Handle to a mesh stored in the MeshArena.
+///
+/// The values map directly onto the firstIndex, vertexOffset and indexCount
+/// parameters of vkCmdDrawIndexed, once the arena's index buffer is bound with indexType.
+struct MeshRange {
+public:
+    // Enums
+
+    // Public Fields
+
+    uint32_t firstIndex{0}; /// @brief First index of the mesh in the arena's index buffer, in indices of indexType.
+    uint32_t indexCount{0}; /// @brief Number of indices of the mesh.
+    int32_t vertexOffset{0}; /// @brief First vertex of the mesh in the arena's vertex buffer.
+    uint32_t vertexCount{0}; /// @brief Number of vertices of the mesh.
+    VkIndexType indexType{VK_INDEX_TYPE_UINT32}; /// @brief Size of the mesh's indices, 16 bits when every vertex can be reached with them.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    MeshRange() = default;
+
+    /// @brief Default deconstructor.
+    ~MeshRange() = default;
+
+    // Public Methods
+
+    /// @brief Checks whether the range points at uploaded data.
+    /// @return True if the range holds at least one index.
+    inline bool IsValid() const { return indexCount != 0; }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
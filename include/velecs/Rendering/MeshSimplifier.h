@@ -0,0 +1,165 @@
+/// @file    MeshSimplifier.h
+/// @author  Matthew Green
+/// @date    2026-10-18 04:20:51
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Rendering/SimpleVertex.h"
+
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace velecs {
+
+/// @class MeshSimplifier
+/// @brief Reduces the triangle count of a mesh by edge collapse with a quadric error metric.
+///
+/// Every vertex accumulates the planes of the triangles around it in a quadric, which measures
+/// the squared distance of a point to those planes. The edge whose collapse moves its vertex the
+/// least away from the planes is collapsed first. Vertices only move onto their neighbors, so the
+/// simplified triangles index the original vertices and no vertex data is created.
+///
+/// Simplify can be called repeatedly with decreasing targets. The quadrics keep accumulating, so
+/// every call continues from the previous result and its error covers every collapse so far.
+class MeshSimplifier {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr double BOUNDARY_WEIGHT = 4.0; /// @brief Weight of the planes keeping open borders in place.
+    static constexpr float MIN_NORMAL_DOT = 0.2f; /// @brief Smallest cosine between a triangle's normal before and after a collapse.
+
+    // Constructors and Destructors
+
+    /// @brief Constructor. Welds vertices sharing a position and builds the initial quadrics.
+    /// @param[in] vertices The vertices of the mesh.
+    /// @param[in] indices The triangle list of the mesh.
+    MeshSimplifier(const std::vector<SimpleVertex>& vertices, const std::vector<uint32_t>& indices);
+
+    /// @brief Default deconstructor.
+    ~MeshSimplifier() = default;
+
+    // Public Methods
+
+    /// @brief Collapses edges until the mesh holds at most the target number of indices or no edge can be collapsed.
+    /// @param[in] targetIndexCount The number of indices to reduce the mesh to.
+    /// @return The number of indices left.
+    uint32_t Simplify(const uint32_t targetIndexCount);
+
+    /// @brief Gets the number of indices of the simplified mesh.
+    /// @return Three times the number of triangles left.
+    inline uint32_t GetIndexCount() const { return liveTriangles * 3; }
+
+    /// @brief Gets the largest deviation introduced by the collapses so far.
+    /// @return A local space distance bounding how far the simplified surface is from the original one.
+    inline float GetError() const { return error; }
+
+    /// @brief Appends the triangles of the simplified mesh.
+    /// @param[in,out] indices The list to append to. The indices refer to the vertices passed to the constructor.
+    void AppendIndices(std::vector<uint32_t>& indices) const;
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    /// @struct Quadric
+    /// @brief Symmetric 4x4 matrix summing the squared distances to a set of planes.
+    struct Quadric {
+        double a2{0.0}, ab{0.0}, ac{0.0}, ad{0.0};
+        double b2{0.0}, bc{0.0}, bd{0.0};
+        double c2{0.0}, cd{0.0};
+        double d2{0.0};
+
+        /// @brief Adds the plane ax + by + cz + d = 0.
+        /// @param[in] normal The unit normal (a, b, c) of the plane.
+        /// @param[in] d The offset of the plane.
+        /// @param[in] weight The weight of the plane.
+        void AddPlane(const glm::dvec3& normal, const double d, const double weight);
+
+        /// @brief Adds another quadric.
+        /// @param[in] other The quadric to add.
+        void Add(const Quadric& other);
+
+        /// @brief Evaluates the weighted sum of the squared distances of a point to the planes.
+        /// @param[in] point The point.
+        /// @return The sum, never negative.
+        double Evaluate(const glm::dvec3& point) const;
+    };
+
+    /// @struct Collapse
+    /// @brief Candidate move of a vertex onto a neighbor.
+    struct Collapse {
+        double cost; /// @brief Quadric error of the merged vertex at the target position.
+        uint32_t from; /// @brief Vertex removed by the collapse.
+        uint32_t to; /// @brief Vertex kept by the collapse.
+        uint32_t fromVersion; /// @brief Version of from when the candidate was computed.
+        uint32_t toVersion; /// @brief Version of to when the candidate was computed.
+
+        bool operator>(const Collapse& other) const { return cost > other.cost; }
+    };
+
+    std::vector<uint32_t> remap; /// @brief Welded vertex of every vertex, the first vertex with its position.
+    std::vector<glm::dvec3> positions; /// @brief Position of every vertex, only read for welded vertices.
+    std::vector<Quadric> quadrics;
+    std::vector<uint32_t> versions; /// @brief Bumped whenever the quadric or the neighborhood of a vertex changes.
+    std::vector<bool> removed; /// @brief True for vertices collapsed onto a neighbor.
+
+    std::vector<std::array<uint32_t, 3>> triangles;
+    std::vector<bool> deadTriangles;
+    std::vector<std::vector<uint32_t>> vertexTriangles; /// @brief Triangles around every vertex, may list dead ones.
+    uint32_t liveTriangles{0};
+
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> candidates;
+    float error{0.0f};
+
+    std::vector<uint32_t> neighborScratch;
+    std::vector<uint32_t> otherNeighborScratch;
+
+    // Private Methods
+
+    /// @brief Pushes the cheaper direction of collapsing an edge.
+    /// @param[in] a One end of the edge.
+    /// @param[in] b The other end of the edge.
+    void PushEdge(const uint32_t a, const uint32_t b);
+
+    /// @brief Checks that a collapse keeps the mesh manifold and flips no triangle.
+    /// @param[in] from The vertex to remove.
+    /// @param[in] to The vertex to keep.
+    /// @return True if the collapse is allowed.
+    bool CanCollapse(const uint32_t from, const uint32_t to);
+
+    /// @brief Moves a vertex onto a neighbor, removing the triangles sharing their edge.
+    /// @param[in] from The vertex to remove.
+    /// @param[in] to The vertex to keep.
+    void ApplyCollapse(const uint32_t from, const uint32_t to);
+
+    /// @brief Lists the distinct vertices sharing a live triangle with a vertex.
+    /// @param[in] vertex The vertex.
+    /// @param[out] neighbors The neighbors, sorted.
+    void GatherNeighbors(const uint32_t vertex, std::vector<uint32_t>& neighbors) const;
+
+    /// @brief Computes the unnormalized normal of a triangle with one of its vertices moved.
+    /// @param[in] triangle The triangle.
+    /// @param[in] from The vertex to move.
+    /// @param[in] to The vertex whose position replaces it.
+    /// @return The cross product of two edges, twice the area in length.
+    glm::dvec3 GetNormal(const std::array<uint32_t, 3>& triangle, const uint32_t from, const uint32_t to) const;
+};
+
+} // namespace velecs
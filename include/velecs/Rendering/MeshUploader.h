@@ -0,0 +1,142 @@
+/// @file    MeshUploader.h
+/// @author  Matthew Green
+/// @date    2026-10-17 21:12:03
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Memory/AllocatedBuffer.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <deque>
+#include <vector>
+
+namespace velecs {
+
+class MeshArena;
+struct SimpleMesh;
+
+/// @class MeshUploader
+/// @brief Asynchronous upload service copying SimpleMesh data into the MeshArena.
+///
+/// Mesh data is written into a persistently mapped staging ring and the copies are recorded
+/// into upload batches submitted on the transfer queue. Nothing ever blocks on an upload:
+/// every batch carries a ticket, and a mesh is only drawn once the ticket it was given has retired.
+///
+/// Meshes with at most 65536 vertices get 16-bit indices. Positions are optionally quantized to
+/// QuantizedSimpleVertex, the mesh keeps the dequantization its draws have to apply.
+class MeshUploader {
+public:
+    // Enums
+
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    MeshUploader() = default;
+
+    /// @brief Default deconstructor.
+    ~MeshUploader() = default;
+
+    // Public Methods
+
+    /// @brief Creates the staging ring and the command pool of the upload batches.
+    /// @param[in] device The device the uploads are recorded on.
+    /// @param[in] allocator The allocator the staging ring is created with.
+    /// @param[in] queue The queue the uploads are submitted to.
+    /// @param[in] queueFamily The queue family of queue.
+    /// @param[in] arena The arena the meshes are uploaded into.
+    /// @param[in] stagingSize The size of the staging ring, in bytes.
+    /// @param[in] quantizePositions True if the arena stores QuantizedSimpleVertex instead of SimpleVertex.
+    void Init
+    (
+        VkDevice device,
+        VmaAllocator allocator,
+        VkQueue queue,
+        const uint32_t queueFamily,
+        MeshArena* const arena,
+        const VkDeviceSize stagingSize,
+        const bool quantizePositions = false
+    );
+
+    /// @brief Waits for every in-flight upload and destroys all resources.
+    void Cleanup();
+
+    /// @brief Tries to queue the upload of a mesh.
+    /// @param[in,out] mesh The mesh to upload. Its range and ticket are set on success.
+    /// @return True if the upload was recorded, false if the staging ring or the arena is currently full.
+    /// @throws std::runtime_error if the mesh has no vertices or indices, or can never fit into the staging ring.
+    bool TryEnqueue(SimpleMesh& mesh);
+
+    /// @brief Submits every upload queued since the last call.
+    void Submit();
+
+    /// @brief Retires the upload batches the GPU has finished, releasing their staging space.
+    void Poll();
+
+    /// @brief Checks whether the upload that handed out a ticket has retired.
+    /// @param[in] ticket The ticket of the upload.
+    /// @return True if the uploaded data can be read by the GPU.
+    inline bool IsComplete(const uint64_t ticket) const { return ticket <= completedTicket; }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    /// @brief Upload commands recorded into one command buffer and submitted together.
+    struct UploadBatch {
+        VkCommandBuffer commandBuffer{VK_NULL_HANDLE}; /// @brief Command buffer recording the copies.
+        VkFence fence{VK_NULL_HANDLE}; /// @brief Signaled once the copies have executed.
+        uint64_t ticket{0}; /// @brief Ticket handed out to every mesh of the batch.
+        VkDeviceSize ringEnd{0}; /// @brief Ring head once the batch was recorded; the tail moves here when it retires.
+    };
+
+    // Private Fields
+
+    VkDevice device{VK_NULL_HANDLE}; /// @brief Device the uploads are recorded on.
+    VmaAllocator allocator{nullptr}; /// @brief Allocator the staging ring was created with.
+    VkQueue queue{VK_NULL_HANDLE}; /// @brief Queue the uploads are submitted to.
+    MeshArena* arena{nullptr}; /// @brief Arena the meshes are uploaded into.
+    bool quantizePositions{false}; /// @brief Whether positions are written as QuantizedSimpleVertex.
+    bool arenaFull{false}; /// @brief Whether the last arena allocation failed, so a full arena is only logged once.
+
+    VkCommandPool commandPool{VK_NULL_HANDLE}; /// @brief Pool the batches' command buffers are allocated from.
+
+    AllocatedBuffer stagingBuffer; /// @brief Host-visible staging ring.
+    char* stagingMapped{nullptr}; /// @brief Persistent mapping of stagingBuffer.
+    VkDeviceSize stagingSize{0}; /// @brief Size of the staging ring, in bytes.
+    VkDeviceSize ringHead{0}; /// @brief Total number of bytes ever written into the ring.
+    VkDeviceSize ringTail{0}; /// @brief Total number of bytes ever released from the ring.
+
+    UploadBatch recordingBatch; /// @brief Batch currently recording copies.
+    bool isRecording{false}; /// @brief Whether recordingBatch has begun recording.
+    std::deque<UploadBatch> inFlightBatches; /// @brief Submitted batches, oldest first.
+    std::vector<UploadBatch> freeBatches; /// @brief Retired batches ready to be reused.
+
+    uint64_t nextTicket{1}; /// @brief Ticket of the next batch to begin recording.
+    uint64_t completedTicket{0}; /// @brief Every ticket up to and including this one has retired.
+
+    // Private Methods
+
+    /// @brief Reserves contiguous space in the staging ring.
+    /// @param[in] size The number of bytes to reserve.
+    /// @param[out] outOffset The offset of the reserved space inside the staging buffer.
+    /// @return True if enough space was free.
+    bool TryAllocateStaging(const VkDeviceSize size, VkDeviceSize& outOffset);
+
+    /// @brief Begins recording a new batch if none is recording yet.
+    void BeginBatch();
+};
+
+} // namespace velecs
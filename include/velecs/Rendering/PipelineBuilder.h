@@ -46,8 +46,16 @@ public:
     ///
     /// @param device The Vulkan device to use for pipeline creation.
     /// @param pass The render pass with which this pipeline will be used.
+    /// @param cache The pipeline cache to look the pipeline up in and store it into, or VK_NULL_HANDLE.
     /// @return The created Vulkan pipeline.
-    VkPipeline BuildPipeline(VkDevice device, VkRenderPass pass);
+    VkPipeline BuildPipeline(VkDevice device, VkRenderPass pass, VkPipelineCache cache = VK_NULL_HANDLE);
+
+    /// @brief Fills the create info of the pipeline without creating it, so several can be created in one call.
+    ///
+    /// The returned structure points into this builder, which must outlive its use and not be modified in between.
+    /// @param pass The render pass with which this pipeline will be used.
+    /// @return The create info of the pipeline.
+    VkGraphicsPipelineCreateInfo GetCreateInfo(VkRenderPass pass);
 
 protected:
     // Protected Fields
@@ -57,6 +65,11 @@ protected:
 private:
     // Private Fields
 
+    VkPipelineViewportStateCreateInfo _viewportState{};
+    VkDynamicState _dynamicStates[2]{};
+    VkPipelineDynamicStateCreateInfo _dynamicStateInfo{};
+    VkPipelineColorBlendStateCreateInfo _colorBlending{};
+
     // Private Methods
 };
 
@@ -0,0 +1,91 @@
+/// @file    PipelineCache.h
+/// @author  Matthew Green
+/// @date    2026-10-18 00:12:37
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace velecs {
+
+/// @class PipelineCache
+/// @brief VkPipelineCache persisted to disk between runs.
+///
+/// The cache file is only handed to the driver if its header matches the vendor, device and
+/// pipeline cache UUID of the current physical device. A stale or foreign file is ignored and
+/// the pipelines are built cold, then overwritten on shutdown.
+class PipelineCache {
+public:
+    // Enums
+
+    // Public Fields
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    PipelineCache() = default;
+
+    /// @brief Default deconstructor.
+    ~PipelineCache() = default;
+
+    // Public Methods
+
+    /// @brief Loads the cache file if it is valid for the device and creates the pipeline cache.
+    /// @param[in] device The device the pipelines are created on.
+    /// @param[in] physicalDevice The physical device the cache file is validated against.
+    /// @param[in] filePath The path of the cache file.
+    /// @throws std::runtime_error if the pipeline cache cannot be created.
+    void Init(VkDevice device, VkPhysicalDevice physicalDevice, const std::string& filePath);
+
+    /// @brief Writes the cache back to disk and destroys it.
+    void Cleanup();
+
+    /// @brief Writes the current content of the cache to the cache file.
+    /// @return True if the file was written.
+    bool Save() const;
+
+    /// @brief Gets the pipeline cache to pass to vkCreate*Pipelines.
+    /// @return The pipeline cache, VK_NULL_HANDLE before Init.
+    inline VkPipelineCache Get() const { return cache; }
+
+    /// @brief Checks whether the cache was created from a valid file.
+    /// @return True if pipelines are expected to hit the cache.
+    inline bool IsWarm() const { return loadedSize > 0; }
+
+    /// @brief Gets the size of the data loaded from the cache file.
+    /// @return The size in bytes, 0 for a cold cache.
+    inline size_t GetLoadedSize() const { return loadedSize; }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    VkDevice device{VK_NULL_HANDLE};
+    VkPipelineCache cache{VK_NULL_HANDLE};
+    std::string filePath;
+    size_t loadedSize{0};
+
+    // Private Methods
+
+    /// @brief Checks the header of a cache file against the physical device.
+    /// @param[in] data The content of the cache file.
+    /// @param[in] properties The properties of the physical device.
+    /// @return True if the driver can use the data.
+    static bool IsCompatible(const std::vector<uint8_t>& data, const VkPhysicalDeviceProperties& properties);
+};
+
+} // namespace velecs
@@ -0,0 +1,97 @@
+/// @file    PipelineRegistry.h
+/// @author  Matthew Green
+/// @date    2026-10-18 00:48:20
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Rendering/PipelineBuilder.h"
+#include "velecs/Rendering/VertexInputAttributeDescriptor.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <string>
+#include <vector>
+
+namespace velecs {
+
+class JobSystem;
+
+/// @class PipelineRegistry
+/// @brief Collects graphics pipeline descriptions and creates them all at once.
+///
+/// Every distinct shader is loaded once, in parallel, then the pipelines are split into one
+/// batched vkCreateGraphicsPipelines call per worker thread, all sharing the same pipeline cache.
+class PipelineRegistry {
+public:
+    // Enums
+
+    // Public Fields
+
+    /// @struct Description
+    /// @brief Everything that differs between two pipelines built from the same fixed function state.
+    struct Description {
+        VkPipeline* outPipeline{nullptr}; /// @brief Where the created pipeline is written.
+        std::string vertShader; /// @brief Vertex shader path, relative to Path::SHADERS_DIR.
+        std::string fragShader; /// @brief Fragment shader path, relative to Path::SHADERS_DIR.
+        VkPipelineLayout layout{VK_NULL_HANDLE};
+        VertexInputAttributeDescriptor vertexInput;
+    };
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    PipelineRegistry() = default;
+
+    /// @brief Default deconstructor.
+    ~PipelineRegistry() = default;
+
+    // Public Methods
+
+    /// @brief Requests a pipeline. Nothing is created before Build.
+    /// @param[out] outPipeline Where the pipeline is written by Build. Must stay valid until then.
+    /// @param[in] vertShader Vertex shader path, relative to Path::SHADERS_DIR.
+    /// @param[in] fragShader Fragment shader path, relative to Path::SHADERS_DIR.
+    /// @param[in] layout The layout of the pipeline.
+    /// @param[in] vertexInput The vertex bindings and attributes of the pipeline.
+    void Add
+    (
+        VkPipeline* const outPipeline,
+        const std::string& vertShader,
+        const std::string& fragShader,
+        VkPipelineLayout layout,
+        const VertexInputAttributeDescriptor& vertexInput
+    );
+
+    /// @brief Creates every requested pipeline and clears the registry.
+    /// @param[in] device The device the pipelines are created on.
+    /// @param[in] pass The render pass the pipelines are used with.
+    /// @param[in] fixedState Builder holding the fixed function state shared by every pipeline.
+    /// @param[in] cache The pipeline cache shared by every creation, or VK_NULL_HANDLE.
+    /// @param[in] jobSystem The threads loading the shaders and creating the pipelines.
+    /// @throws std::runtime_error if a shader cannot be loaded.
+    void Build(VkDevice device, VkRenderPass pass, const PipelineBuilder& fixedState, VkPipelineCache cache, JobSystem& jobSystem);
+
+    /// @brief Gets the number of pipelines waiting for Build.
+    /// @return The pipeline count.
+    inline size_t GetCount() const { return descriptions.size(); }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    std::vector<Description> descriptions;
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -0,0 +1,79 @@
+/// @file    QuantizedSimpleVertex.h
+/// @author  Matthew Green
+/// @date    2026-10-18 05:02:44
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include "velecs/Rendering/VertexInputAttributeDescriptor.h"
+#include "velecs/Math/Bounds.h"
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct QuantizedSimpleVertex
+/// @brief SimpleVertex with its position stored as 16-bit normalized integers, 8 bytes instead of 12.
+///
+/// Positions are quantized over the bounding box of their mesh with a single scale for every axis.
+/// The vertex input unit turns them back into floats in [0, 1], the mesh's dequantization matrix
+/// maps those to local space and is folded into the model matrix, so the shaders are unchanged.
+struct QuantizedSimpleVertex {
+public:
+    // Enums
+
+    // Public Fields
+
+    uint16_t position[4]; /// @brief x, y and z in [0, 65535], the fourth component pads the vertex to 8 bytes.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    QuantizedSimpleVertex() = default;
+
+    /// @brief Default deconstructor.
+    ~QuantizedSimpleVertex() = default;
+
+    // Public Methods
+
+    /// @brief Gets the vertex input of the pipelines drawing quantized meshes, matching SimpleVertex's locations.
+    /// @return A single per-vertex binding with the position at location 0.
+    static VertexInputAttributeDescriptor GetVertexDescription();
+
+    /// @brief Computes how the positions of a mesh are quantized.
+    /// @param[in] bounds The local space bounds of the mesh.
+    /// @return The offset in xyz and the scale in w, a dequantized position is offset + scale * normalized.
+    static glm::vec4 ComputeDequantization(const AABB& bounds);
+
+    /// @brief Quantizes a position.
+    /// @param[in] position The local space position.
+    /// @param[in] dequantization The value returned by ComputeDequantization for the position's mesh.
+    /// @return The quantized vertex.
+    static QuantizedSimpleVertex Quantize(const glm::vec3& position, const glm::vec4& dequantization);
+
+    /// @brief Builds the matrix turning normalized positions back into local space.
+    /// @param[in] dequantization The value returned by ComputeDequantization.
+    /// @return A translation by the offset times a uniform scale.
+    static glm::mat4 GetDequantizationMatrix(const glm::vec4& dequantization);
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -0,0 +1,129 @@
+/// @file    RenderQueue.h
+/// @author  Matthew Green
+/// @date    2026-10-17 21:58:36
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace velecs {
+
+struct SimpleMesh;
+
+/// @struct DrawCommand
+/// @brief Everything needed to record the draw of one entity.
+struct DrawCommand {
+    glm::mat4 modelMatrix; /// @brief Local to world matrix of the entity.
+    glm::vec4 color; /// @brief Color of the entity's material.
+    const SimpleMesh* mesh{nullptr}; /// @brief Mesh to draw. Already uploaded.
+    uint32_t lod{0}; /// @brief Level of detail of mesh to draw.
+    VkPipeline pipeline{VK_NULL_HANDLE}; /// @brief Pipeline to draw with.
+    VkPipelineLayout pipelineLayout{VK_NULL_HANDLE}; /// @brief Layout of pipeline, used for push constants.
+    bool instanced{false}; /// @brief Whether pipeline reads its per-instance data from the instance buffer.
+};
+
+/// @class RenderQueue
+/// @brief Per-frame list of draw commands sorted by a packed 64-bit key.
+///
+/// The key packs, from most to least significant bits, a pipeline id (16 bits), a mesh and level of
+/// detail id (24 bits) and a quantized view depth (24 bits). Sorting by it groups draws by pipeline,
+/// then by mesh, then front to back, so walking the sorted queue only changes state when it has to and
+/// consecutive instanced commands with the same pipeline, mesh and level collapse into one draw.
+class RenderQueue {
+public:
+    // Enums
+
+    // Public Fields
+
+    static constexpr uint32_t PIPELINE_BITS = 16; /// @brief Number of key bits holding the pipeline id.
+    static constexpr uint32_t MESH_BITS = 24; /// @brief Number of key bits holding the mesh id.
+    static constexpr uint32_t DEPTH_BITS = 24; /// @brief Number of key bits holding the quantized depth.
+
+    // Constructors and Destructors
+
+    /// @brief Default constructor.
+    RenderQueue() = default;
+
+    /// @brief Default deconstructor.
+    ~RenderQueue() = default;
+
+    // Public Methods
+
+    /// @brief Empties the queue. Pipeline and mesh ids are reassigned from scratch.
+    void Clear();
+
+    /// @brief Adds a draw command to the queue.
+    /// @param[in] command The command to add.
+    /// @param[in] depth The normalized view depth of the entity, clamped to [0, 1].
+    void Push(const DrawCommand& command, const float depth);
+
+    /// @brief Sorts the queue by key with an LSD radix sort.
+    void Sort();
+
+    /// @brief Gets the number of commands in the queue.
+    /// @return The number of commands.
+    inline size_t Size() const { return commands.size(); }
+
+    /// @brief Gets a command in sorted order. Only valid after Sort.
+    /// @param[in] index The position of the command in the sorted queue.
+    /// @return The command.
+    inline const DrawCommand& GetSorted(const size_t index) const { return commands[sortedIndices[index]]; }
+
+    /// @brief Gets the key of a command in sorted order. Only valid after Sort.
+    /// @param[in] index The position of the command in the sorted queue.
+    /// @return The sort key of the command.
+    inline uint64_t GetSortedKey(const size_t index) const { return sortedKeys[index]; }
+
+    /// @brief Counts how many pipeline changes walking the queue in submission order would have needed.
+    /// @return The number of pipeline binds without sorting.
+    uint32_t CountUnsortedPipelineChanges() const;
+
+    /// @brief Packs a sort key.
+    /// @param[in] pipelineId The id of the pipeline, truncated to PIPELINE_BITS.
+    /// @param[in] meshId The id of the mesh, truncated to MESH_BITS.
+    /// @param[in] depth The normalized view depth, clamped to [0, 1].
+    /// @return The packed key.
+    static uint64_t MakeSortKey(const uint32_t pipelineId, const uint32_t meshId, const float depth);
+
+    /// @brief Checks whether two keys share the same pipeline and mesh.
+    /// @param[in] a The first key.
+    /// @param[in] b The second key.
+    /// @return True if only the depth differs.
+    static inline bool IsSameBatch(const uint64_t a, const uint64_t b) { return (a >> DEPTH_BITS) == (b >> DEPTH_BITS); }
+
+protected:
+    // Protected Fields
+
+    // Protected Methods
+
+private:
+    // Private Fields
+
+    std::vector<DrawCommand> commands; /// @brief Commands in submission order.
+    std::vector<uint64_t> keys; /// @brief Sort key of every command, in submission order.
+
+    std::vector<uint64_t> sortedKeys; /// @brief Keys after sorting.
+    std::vector<uint32_t> sortedIndices; /// @brief Indices into commands after sorting.
+    std::vector<uint64_t> scratchKeys; /// @brief Ping-pong buffer of the radix sort.
+    std::vector<uint32_t> scratchIndices; /// @brief Ping-pong buffer of the radix sort.
+
+    std::unordered_map<VkPipeline, uint32_t> pipelineIds; /// @brief Ids handed out to pipelines this frame.
+    std::unordered_map<const SimpleMesh*, uint32_t> meshIds; /// @brief Ids handed out to meshes this frame.
+
+    // Private Methods
+};
+
+} // namespace velecs
@@ -0,0 +1,42 @@
+/// @file    RenderStats.h
+/// @author  Matthew Green
+/// @date    2026-10-17 22:12:50
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#pragma once
+
+#include <cstdint>
+
+namespace velecs {
+
+/// @struct RenderStats
+/// @brief Counters describing the commands recorded during the last frame.
+struct RenderStats {
+    // Enums
+
+    // Public Fields
+
+    uint32_t drawCommands{0}; /// @brief Entities that made it into the render queue.
+    uint32_t culled{0}; /// @brief Entities rejected by frustum culling.
+    uint32_t gpuDrivenObjects{0}; /// @brief Entities handed to the GPUCullingPass, culled on the GPU.
+    uint32_t drawCalls{0}; /// @brief vkCmdDrawIndexed calls recorded.
+    uint32_t triangles{0}; /// @brief Triangles drawn by the recorded vkCmdDrawIndexed calls.
+    uint32_t simplified{0}; /// @brief Entities drawn with a level of detail other than full detail.
+    uint32_t pipelineBinds{0}; /// @brief vkCmdBindPipeline calls recorded.
+    uint32_t pipelineBindsUnsorted{0}; /// @brief Pipeline binds the queue would have needed in extraction order.
+    uint32_t recordingJobs{0}; /// @brief Secondary command buffers the render queue was recorded into.
+    float recordingTimeMs{0.0f}; /// @brief CPU time spent recording the render queue, in milliseconds.
+
+    // Public Methods
+
+    /// @brief Gets the number of pipeline binds elided by sorting.
+    /// @return The difference between the unsorted and the recorded pipeline binds.
+    inline uint32_t GetPipelineBindsSaved() const { return pipelineBindsUnsorted > pipelineBinds ? pipelineBindsUnsorted - pipelineBinds : 0; }
+};
+
+} // namespace velecs
@@ -0,0 +1,157 @@
+/// @file    JobSystem.cpp
+/// @author  Matthew Green
+/// @date    2026-10-17 23:41:12
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Core/JobSystem.h"
+
+#include <algorithm>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+JobSystem::JobSystem(const uint32_t threadCount)
+{
+    uint32_t count = threadCount;
+    if (count == 0)
+    {
+        count = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    //the calling thread is one of them
+    workers.reserve(count - 1);
+    for (uint32_t i = 1; i < count; ++i)
+    {
+        workers.emplace_back(&JobSystem::WorkerLoop, this);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+// Public Methods
+
+void JobSystem::ParallelFor(const uint32_t count, const std::function<void(uint32_t index)>& job)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    if (workers.empty() || count == 1)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            job(i);
+        }
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        //a worker waking up late from the previous loop may still be reading it
+        doneCondition.wait(lock, [this]() { return activeWorkers == 0; });
+
+        this->job = &job;
+        jobCount = count;
+        nextJob.store(0, std::memory_order_relaxed);
+        exception = nullptr;
+        ++generation;
+    }
+    wakeCondition.notify_all();
+
+    RunJobs();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this]() { return activeWorkers == 0; });
+
+    this->job = nullptr;
+    if (exception)
+    {
+        std::exception_ptr thrown = exception;
+        exception = nullptr;
+        std::rethrow_exception(thrown);
+    }
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void JobSystem::WorkerLoop()
+{
+    uint64_t seenGeneration = 0;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        wakeCondition.wait(lock, [&]() { return stopping || generation != seenGeneration; });
+        if (stopping)
+        {
+            return;
+        }
+
+        seenGeneration = generation;
+        ++activeWorkers;
+
+        lock.unlock();
+        RunJobs();
+        lock.lock();
+
+        if (--activeWorkers == 0)
+        {
+            doneCondition.notify_all();
+        }
+    }
+}
+
+void JobSystem::RunJobs()
+{
+    while (true)
+    {
+        const uint32_t index = nextJob.fetch_add(1, std::memory_order_relaxed);
+        if (index >= jobCount)
+        {
+            return;
+        }
+
+        try
+        {
+            (*job)(index);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!exception)
+            {
+                exception = std::current_exception();
+            }
+        }
+    }
+}
+
+} // namespace velecs
@@ -24,12 +24,14 @@ const Material* const Material::Create
     const std::string& path,
     VkPipeline* const pipeline,
     VkPipelineLayout* const pipelineLayout,
-    const Color32 color /*= Color32::MAGENTA*/
+    const Color32 color /*= Color32::MAGENTA*/,
+    VkPipeline* const instancedPipeline /*= nullptr*/,
+    VkPipeline* const indirectPipeline /*= nullptr*/
 )
 {
     flecs::entity entity = ecs.entity(path.c_str())
         .is_a<Material>()
-        .set<Material>({color, pipeline, pipelineLayout})
+        .set<Material>({color, pipeline, pipelineLayout, instancedPipeline, indirectPipeline})
         ;
     return entity.get<Material>();
 }
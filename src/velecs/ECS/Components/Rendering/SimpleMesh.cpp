@@ -12,6 +12,8 @@
 
 #include "velecs/Math/Vec3.h"
 
+#include "velecs/Rendering/MeshSimplifier.h"
+
 #include "velecs/FileManagement/Path.h"
 #include "velecs/FileManagement/File.h"
 
@@ -19,12 +21,81 @@
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+
 namespace velecs {
 
 // Public Fields
 
 // Constructors and Destructors
 
+SimpleMesh::SimpleMesh(const SimpleMesh& other)
+    : _vertices(other._vertices), _indices(other._indices), _lods(other._lods),
+    _bounds(other._bounds), _boundingSphere(other._boundingSphere)
+{
+}
+
+SimpleMesh::SimpleMesh(SimpleMesh&& other) noexcept
+    : _vertices(std::move(other._vertices)), _indices(std::move(other._indices)), _lods(std::move(other._lods)),
+    _range(other._range), _uploadTicket(other._uploadTicket), _releasedRanges(std::move(other._releasedRanges)),
+    _positionDequantization(other._positionDequantization), _bounds(other._bounds), _boundingSphere(other._boundingSphere)
+{
+    other._range = MeshRange();
+    other._uploadTicket = 0;
+    other._releasedRanges.reset();
+}
+
+SimpleMesh& SimpleMesh::operator=(const SimpleMesh& other)
+{
+    if (this == &other)
+    {
+        return *this;
+    }
+
+    //overwritten with a set on the entity, on_remove never sees the former range
+    ReleaseRange();
+
+    _vertices = other._vertices;
+    _indices = other._indices;
+    _lods = other._lods;
+    _bounds = other._bounds;
+    _boundingSphere = other._boundingSphere;
+
+    //a copy sharing the range would free it twice, it is uploaded again instead
+    _positionDequantization = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+
+    return *this;
+}
+
+SimpleMesh& SimpleMesh::operator=(SimpleMesh&& other) noexcept
+{
+    if (this == &other)
+    {
+        return *this;
+    }
+
+    ReleaseRange();
+
+    _vertices = std::move(other._vertices);
+    _indices = std::move(other._indices);
+    _lods = std::move(other._lods);
+    _range = other._range;
+    _uploadTicket = other._uploadTicket;
+    _releasedRanges = std::move(other._releasedRanges);
+    _positionDequantization = other._positionDequantization;
+    _bounds = other._bounds;
+    _boundingSphere = other._boundingSphere;
+
+    other._range = MeshRange();
+    other._uploadTicket = 0;
+    other._releasedRanges.reset();
+
+    return *this;
+}
+
 // Public Methods
 
 const SimpleMesh& SimpleMesh::EQUILATERAL_TRIANGLE()
@@ -45,6 +116,20 @@ const SimpleMesh& SimpleMesh::MONKEY()
     return MONKEY;
 }
 
+void SimpleMesh::ReleaseRange()
+{
+    //once the renderer is gone, so is the arena the range was in
+    const std::shared_ptr<std::vector<std::pair<MeshRange, uint64_t>>> releasedRanges = _releasedRanges.lock();
+    if (_range.IsValid() && releasedRanges != nullptr)
+    {
+        releasedRanges->emplace_back(_range, _uploadTicket);
+    }
+
+    _range = MeshRange();
+    _uploadTicket = 0;
+    _releasedRanges.reset();
+}
+
 SimpleMesh SimpleMesh::Load(std::string filePath)
 {
     filePath = Path::Combine(Path::MESHES_DIR, filePath);
@@ -99,6 +184,9 @@ SimpleMesh SimpleMesh::Load(std::string filePath)
         }
     }
 
+    mesh.RecalculateBounds();
+    mesh.GenerateLODs();
+
     return mesh;
 }
 
@@ -115,6 +203,115 @@ bool SimpleMesh::TryLoad(const std::string& filePath, SimpleMesh*& mesh)
     return true;
 }
 
+void SimpleMesh::RecalculateBounds()
+{
+    if (_vertices.empty())
+    {
+        _bounds = AABB();
+        _boundingSphere = BoundingSphere();
+        return;
+    }
+
+    glm::vec3 min = _vertices[0].position;
+    glm::vec3 max = _vertices[0].position;
+    for (const SimpleVertex& vertex : _vertices)
+    {
+        min = glm::min(min, vertex.position);
+        max = glm::max(max, vertex.position);
+    }
+    _bounds = AABB(min, max);
+
+    // centered on the box, tighter than the half diagonal for most meshes
+    const glm::vec3 center = _bounds.GetCenter();
+    float radiusSquared = 0.0f;
+    for (const SimpleVertex& vertex : _vertices)
+    {
+        const glm::vec3 offset = vertex.position - center;
+        radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+    }
+    _boundingSphere = BoundingSphere(center, std::sqrt(radiusSquared));
+}
+
+void SimpleMesh::GenerateLODs(const uint32_t maxLODs)
+{
+    //drop the levels of a previous call, only the full detail triangles are simplified
+    if (!_lods.empty())
+    {
+        _indices.resize(_lods[0].indexCount);
+        _lods.clear();
+    }
+
+    const uint32_t fullIndexCount = (uint32_t)_indices.size();
+    if (maxLODs <= 1 || fullIndexCount < MIN_LOD_TRIANGLES * 3 * 2)
+    {
+        return; // too small for a coarser level to be worth it
+    }
+
+    MeshLOD fullDetail;
+    fullDetail.indexCount = fullIndexCount;
+    _lods.push_back(fullDetail);
+
+    //every level continues from the previous one, so the errors grow along the chain
+    MeshSimplifier simplifier(_vertices, _indices);
+    uint32_t previousIndexCount = fullIndexCount;
+    while (_lods.size() < maxLODs)
+    {
+        const uint32_t targetTriangles = (uint32_t)((float)(previousIndexCount / 3) * LOD_REDUCTION);
+        if (targetTriangles < MIN_LOD_TRIANGLES)
+        {
+            break;
+        }
+
+        const uint32_t indexCount = simplifier.Simplify(targetTriangles * 3);
+        if (indexCount * 4 > previousIndexCount * 3)
+        {
+            break; // stuck on borders or flips, the level would save less than a quarter
+        }
+
+        MeshLOD lod;
+        lod.firstIndex = (uint32_t)_indices.size();
+        lod.indexCount = indexCount;
+        lod.error = simplifier.GetError();
+        _lods.push_back(lod);
+
+        simplifier.AppendIndices(_indices);
+        previousIndexCount = indexCount;
+    }
+
+    if (_lods.size() == 1)
+    {
+        _lods.clear();
+    }
+}
+
+MeshRange SimpleMesh::GetLODRange(const uint32_t lod) const
+{
+    if (_lods.empty())
+    {
+        return _range;
+    }
+
+    MeshRange range = _range;
+    range.firstIndex += _lods[lod].firstIndex;
+    range.indexCount = _lods[lod].indexCount;
+    return range;
+}
+
+uint32_t SimpleMesh::SelectLOD(const float pixelsPerUnit, const float thresholdPixels) const
+{
+    //the errors grow along the chain, stop at the first level that would show
+    uint32_t selected = 0;
+    for (uint32_t lod = 1; lod < _lods.size(); ++lod)
+    {
+        if (_lods[lod].error * pixelsPerUnit > thresholdPixels)
+        {
+            break;
+        }
+        selected = lod;
+    }
+    return selected;
+}
+
 // Protected Fields
 
 // Protected Methods
@@ -16,6 +16,12 @@
 #include <glm/gtc/matrix_transform.hpp>  // For transformation functions
 
 #include "velecs/Math/GLMUtility.h"
+#include "velecs/Math/ScreenProjection.h"
+#include "velecs/Math/TransformBatch.h"
+
+#include "velecs/ECS/Components/Rendering/CameraData.h"
+
+#include <vector>
 
 namespace velecs {
 
@@ -23,27 +29,30 @@ namespace velecs {
 
 // Constructors and Destructors
 
-Transform::Transform(flecs::entity entity, Vec3 position /* = Vec3::ZERO */, Vec3 rotation /* = Vec3::ZERO */, Vec3 scale /* = Vec3::ONE */)
-    : entity(entity), position(position), rotation(rotation), scale(scale) {}
+Transform::Transform(Vec3 position, Vec3 rotation /* = Vec3::ZERO */, Vec3 scale /* = Vec3::ONE */)
+    : position(position), scale(scale)
+{
+    SetEulerAngles(rotation);
+}
 
 // Public Methods
 
-flecs::entity Transform::GetParent() const
+flecs::entity Transform::GetParent(const flecs::entity entity)
 {
     if (entity == flecs::entity::null())
     {
-        throw std::runtime_error("Transform's entity handle was never set.");
+        throw std::runtime_error("Transform's entity handle is null.");
     }
 
     return entity.parent();
 }
 
-bool Transform::TryGetParent(flecs::entity& parentEntity) const
+bool Transform::TryGetParent(const flecs::entity entity, flecs::entity& parentEntity)
 {
     parentEntity = flecs::entity::null();
     try
     {
-        parentEntity = GetParent();
+        parentEntity = GetParent(entity);
     }
     catch (std::exception e)
     {
@@ -52,9 +61,9 @@ bool Transform::TryGetParent(flecs::entity& parentEntity) const
     return true;
 }
 
-const Transform* const Transform::GetParentTransform() const
+const Transform* const Transform::GetParentTransform(const flecs::entity entity)
 {
-    flecs::entity parent = GetParent();
+    flecs::entity parent = GetParent(entity);
     if (parent == flecs::entity::null())
     {
         throw std::runtime_error("Transform's entity does not have a parent.");
@@ -62,12 +71,12 @@ const Transform* const Transform::GetParentTransform() const
     return parent.get<Transform>();
 }
 
-bool Transform::TryGetParentTransform(const Transform*& transform) const
+bool Transform::TryGetParentTransform(const flecs::entity entity, const Transform*& transform)
 {
     transform = nullptr;
 
     flecs::entity parent;
-    if (!TryGetParent(parent))
+    if (!TryGetParent(entity, parent))
     {
         return false;
     }
@@ -81,9 +90,9 @@ bool Transform::TryGetParentTransform(const Transform*& transform) const
     return true;
 }
 
-flecs::entity Transform::GetCameraEntity() const
+flecs::entity Transform::GetCameraEntity(const flecs::world& ecs)
 {
-    const MainCamera * const mainCamera = entity.world().get<MainCamera>();
+    const MainCamera * const mainCamera = ecs.get<MainCamera>();
     if (!mainCamera)
     {
         throw std::runtime_error("flecs::world is missing a MainCamera component.");
@@ -98,139 +107,235 @@ flecs::entity Transform::GetCameraEntity() const
     return cameraEntity;
 }
 
-const Transform* const Transform::GetCameraTransform() const
+const Transform* const Transform::GetCameraTransform(const flecs::world& ecs)
 {
-    flecs::entity cameraEntity = GetCameraEntity();
+    flecs::entity cameraEntity = GetCameraEntity(ecs);
 
     const Transform* const transform = cameraEntity.get<Transform>();
 
     return transform;
 }
 
-Transform* const Transform::GetCameraTransform()
+Transform* const Transform::GetCameraTransform(flecs::world& ecs)
 {
-    flecs::entity cameraEntity = GetCameraEntity();
+    flecs::entity cameraEntity = GetCameraEntity(ecs);
 
     Transform* const transform = cameraEntity.get_mut<Transform>();
 
     return transform;
 }
 
-const Vec3 Transform::GetAbsPosition() const
+Vec3 Transform::GetEulerAngles() const
 {
-    glm::mat4 world = GetWorldMatrix();
+    const glm::vec3 degrees = GLMUtility::QuatToEuler(rotation);
+    return Vec3(degrees.x, degrees.y, degrees.z);
+}
+
+void Transform::SetEulerAngles(const Vec3 degrees)
+{
+    rotation = GLMUtility::EulerToQuat(glm::vec3(degrees));
+}
+
+void Transform::SetRotation(const glm::quat& newRotation)
+{
+    rotation = glm::normalize(newRotation);
+}
+
+void Transform::SlerpRotation(const glm::quat& target, const float t)
+{
+    SetRotation(GLMUtility::Slerp(rotation, target, t));
+}
+
+const Vec3 Transform::GetAbsPosition(const flecs::entity entity)
+{
+    glm::mat4 world = GetWorldMatrix(entity);
     glm::vec4 posV4 = world * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
     return Vec3(posV4.x, posV4.y, posV4.z);
 }
 
 Vec3 Transform::GetForwardVector() const
 {
-    // Assuming rotation.x = pitch, rotation.y = yaw, rotation.z = roll
     // For a camera facing along the negative Z-axis by default
-    float yaw = glm::radians(rotation.y);
-    float pitch = glm::radians(rotation.x);
+    const glm::vec3 forward = rotation * glm::vec3(0.0f, 0.0f, -1.0f);
+    return Vec3(forward.x, forward.y, forward.z);
+}
 
-    Vec3 forward
-    {
-        sin(yaw) * cos(pitch),
-        -sin(pitch), // Negative because Y is down in Vulkan
-        -cos(yaw) * cos(pitch)
-    };
+glm::mat4 Transform::GetWorldMatrix(const flecs::entity entity)
+{
+    return GetWorldTransform(entity).matrix;
+}
 
-    return forward.Normalize();
+glm::mat4 Transform::GetWorldMatrixNoScale(const flecs::entity entity)
+{
+    return GetWorldTransform(entity).matrixNoScale;
+}
+
+glm::mat4 Transform::GetViewMatrix(const flecs::entity entity)
+{
+    return glm::inverse(GetWorldTransform(entity).matrixNoScale);
 }
 
-glm::mat4 Transform::GetWorldMatrix() const
+const WorldTransform& Transform::GetWorldTransform(const flecs::entity entity)
 {
-    glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(position));
-    glm::mat4 rotationMatrix = glm::rotate(glm::mat4(1.0f), glm::radians(rotation.x), glm::vec3(1, 0, 0));
-    rotationMatrix = glm::rotate(rotationMatrix, glm::radians(rotation.y), glm::vec3(0, 1, 0));
-    rotationMatrix = glm::rotate(rotationMatrix, glm::radians(rotation.z), glm::vec3(0, 0, 1));
-    glm::mat4 scaleMatrix = glm::scale(glm::mat4(1.0f), glm::vec3(scale));
+    const Transform* const transform = entity ? entity.get<Transform>() : nullptr;
+    if (transform == nullptr)
+    {
+        throw std::runtime_error("Entity does not have a Transform component.");
+    }
+
+    //the parent is resolved first, its version tells whether an ancestor moved since the cache was computed
+    //once the propagation pass ran this only compares, the matrices are rebuilt for what changed since
+    const flecs::entity parent = entity.parent();
+    const bool hasParentTransform = parent && parent.has<Transform>();
+    const WorldTransform* const parentWorld = hasParentTransform ? &GetWorldTransform(parent) : nullptr;
 
-    glm::mat4 localTransformation = translationMatrix * rotationMatrix * scaleMatrix;
+    WorldTransform* const cache = entity.get_mut<WorldTransform>();
+    transform->RefreshWorldTransform(*cache, parentWorld != nullptr ? parent.id() : 0, parentWorld);
+    return *cache;
+}
 
-    const Transform* parentTransform;
-    if (TryGetParentTransform(parentTransform))
+bool Transform::RefreshWorldTransform(WorldTransform& world, const flecs::entity_t parent, const WorldTransform* const parentWorld) const
+{
+    const uint32_t parentVersion = parentWorld != nullptr ? parentWorld->version : 0;
+    const bool localChanged = HasLocalChanged(world);
+    if (!localChanged && world.parent == parent && world.parentVersion == parentVersion)
     {
-        return parentTransform->GetWorldMatrix() * localTransformation;
+        return false;
     }
-    else
+
+    const glm::mat4 parentMatrix = parentWorld != nullptr ? parentWorld->matrix : glm::mat4(1.0f);
+    const glm::mat4 parentMatrixNoScale = parentWorld != nullptr ? parentWorld->matrixNoScale : glm::mat4(1.0f);
+
+    //only the parent moved, the local matrix is still the one composed last time
+    if (localChanged)
     {
-        return localTransformation;
+        world.localMatrix = GetLocalMatrix();
+        world.position = position;
+        world.rotation = rotation;
+        world.scale = scale;
     }
+
+    world.matrix = GLMUtility::MultiplyAffine(parentMatrix, world.localMatrix);
+    world.matrixNoScale = GLMUtility::MultiplyAffine(parentMatrixNoScale, GetLocalMatrixNoScale());
+    world.parent = parent;
+    world.parentVersion = parentVersion;
+    world.BumpVersion();
+
+    return true;
 }
 
-glm::mat4 Transform::GetWorldMatrixNoScale() const
+size_t Transform::RefreshWorldTransforms(const size_t count, const Transform* const transforms, WorldTransform* const worlds,
+    const flecs::entity_t parent, const WorldTransform* const parentWorld)
 {
-    glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(position));
-    glm::mat4 rotationMatrix = glm::rotate(glm::mat4(1.0f), glm::radians(rotation.x), glm::vec3(1, 0, 0));
-    rotationMatrix = glm::rotate(rotationMatrix, glm::radians(rotation.y), glm::vec3(0, 1, 0));
-    rotationMatrix = glm::rotate(rotationMatrix, glm::radians(rotation.z), glm::vec3(0, 0, 1));
-
-    glm::mat4 localTransformation = translationMatrix * rotationMatrix;
+    thread_local std::vector<uint32_t> stale;
+    thread_local std::vector<glm::vec3> positions;
+    thread_local std::vector<glm::quat> rotations;
+    thread_local std::vector<glm::vec3> scales;
+    thread_local std::vector<glm::mat4> locals;
+    thread_local std::vector<glm::mat4> matrices;
+    thread_local std::vector<glm::mat4> matricesNoScale;
+
+    const uint32_t parentVersion = parentWorld != nullptr ? parentWorld->version : 0;
+
+    //the stale entities are packed so the kernel runs over contiguous columns
+    stale.clear();
+    positions.clear();
+    rotations.clear();
+    scales.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Transform& transform = transforms[i];
+        const WorldTransform& world = worlds[i];
+        if (!transform.HasLocalChanged(world) && world.parent == parent && world.parentVersion == parentVersion)
+        {
+            continue;
+        }
+
+        stale.push_back((uint32_t)i);
+        positions.push_back(glm::vec3(transform.position));
+        rotations.push_back(transform.rotation);
+        scales.push_back(glm::vec3(transform.scale));
+    }
 
-    const Transform* parentTransform;
-    if (TryGetParentTransform(parentTransform))
+    const size_t staleCount = stale.size();
+    if (staleCount == 0)
     {
-        return parentTransform->GetWorldMatrixNoScale() * localTransformation;
+        return 0;
     }
-    else
+
+    locals.resize(staleCount);
+    matrices.resize(staleCount);
+    matricesNoScale.resize(staleCount);
+
+    const glm::mat4 identity(1.0f);
+    TransformBatch::Compose
+    (
+        staleCount, positions.data(), rotations.data(), scales.data(),
+        parentWorld != nullptr ? parentWorld->matrix : identity,
+        parentWorld != nullptr ? parentWorld->matrixNoScale : identity,
+        locals.data(), matrices.data(), matricesNoScale.data()
+    );
+
+    for (size_t i = 0; i < staleCount; ++i)
     {
-        return localTransformation;
+        const Transform& transform = transforms[stale[i]];
+        WorldTransform& world = worlds[stale[i]];
+
+        world.localMatrix = locals[i];
+        world.matrix = matrices[i];
+        world.matrixNoScale = matricesNoScale[i];
+        world.position = transform.position;
+        world.rotation = transform.rotation;
+        world.scale = transform.scale;
+        world.parent = parent;
+        world.parentVersion = parentVersion;
+        world.BumpVersion();
     }
+
+    return staleCount;
 }
 
-glm::mat4 Transform::GetViewMatrix() const
+glm::mat4 Transform::GetLocalMatrix() const
 {
-    glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(position));
-    glm::mat4 rotationMatrix = glm::rotate(glm::mat4(1.0f), glm::radians(rotation.x), glm::vec3(1, 0, 0));
-    rotationMatrix = glm::rotate(rotationMatrix, glm::radians(rotation.y), glm::vec3(0, 1, 0));
-    rotationMatrix = glm::rotate(rotationMatrix, glm::radians(rotation.z), glm::vec3(0, 0, 1));
-    glm::mat4 localTransform  = translationMatrix * rotationMatrix;
-
-    const Transform* parentTransform;
-    if (TryGetParentTransform(parentTransform))
-    {
-        return glm::inverse(parentTransform->GetWorldMatrixNoScale() * localTransform);
-    }
-    else
-    {
-        return glm::inverse(localTransform);
-    } 
+    return GLMUtility::ComposeTRS(glm::vec3(position), rotation, glm::vec3(scale));
+}
+
+glm::mat4 Transform::GetLocalMatrixNoScale() const
+{
+    return GLMUtility::ComposeTRS(glm::vec3(position), rotation, glm::vec3(1.0f));
 }
 
-glm::mat4 Transform::GetRenderMatrix(const Transform* const cameraTransform, const PerspectiveCamera* const perspectiveCamera) const
+glm::mat4 Transform::GetRenderMatrix(const flecs::entity entity, const flecs::entity cameraEntity, const PerspectiveCamera* const perspectiveCamera)
 {
     glm::mat4 projection = perspectiveCamera->GetProjectionMatrix();
 
-    glm::mat4 view = cameraTransform->GetViewMatrix();
+    glm::mat4 view = GetViewMatrix(cameraEntity);
 
-    glm::mat4 world = GetWorldMatrix();
+    glm::mat4 world = GetWorldMatrix(entity);
 
     glm::mat4 render = projection * view * world;
 
     return render;
 }
 
-glm::mat4 Transform::GetRenderMatrix(const Transform* const cameraTransform, const OrthoCamera* const orthoCamera) const
+glm::mat4 Transform::GetRenderMatrix(const flecs::entity entity, const flecs::entity cameraEntity, const OrthoCamera* const orthoCamera)
 {
     // Compute the view matrix
-    glm::mat4 view = cameraTransform->GetViewMatrix();
+    glm::mat4 view = GetViewMatrix(cameraEntity);
 
     // Compute the projection matrix
     glm::mat4 projection = orthoCamera->GetProjectionMatrix();
 
     // Compute the model matrix
-    glm::mat4 world = GetWorldMatrix();
+    glm::mat4 world = GetWorldMatrix(entity);
 
     return projection * view * world;
 }
 
-const Vec2 Transform::GetScreenPosition(const Transform* const cameraTransform, const PerspectiveCamera* const perspectiveCamera) const
+const Vec2 Transform::GetScreenPosition(const flecs::entity entity, const flecs::entity cameraEntity, const PerspectiveCamera* const perspectiveCamera)
 {
     // Get clip space pos
-    glm::vec4 clipSpacePos = GetRenderMatrix(cameraTransform, perspectiveCamera) * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    glm::vec4 clipSpacePos = GetRenderMatrix(entity, cameraEntity, perspectiveCamera) * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
 
     // Perspective division to get NDC
     glm::vec3 ndcSpacePos = glm::vec3(clipSpacePos) / clipSpacePos.w;
@@ -245,6 +350,32 @@ const Vec2 Transform::GetScreenPosition(const Transform* const cameraTransform,
     };
 }
 
+void Transform::GetScreenPositions(const flecs::world& ecs, const size_t count, const WorldTransform* const worlds,
+    Vec2* const screenPositions, uint8_t* const clipFlags)
+{
+    const CameraData* const camera = ecs.get<CameraData>();
+    if (camera == nullptr)
+    {
+        throw std::runtime_error("flecs::world is missing a CameraData component.");
+    }
+
+    const MainCamera* const mainCamera = ecs.get<MainCamera>();
+    if (mainCamera == nullptr)
+    {
+        throw std::runtime_error("flecs::world is missing a MainCamera component.");
+    }
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    //the translation of every world matrix, one WorldTransform apart
+    static_assert(sizeof(WorldTransform) % sizeof(float) == 0, "WorldTransform columns are read as floats.");
+    ScreenProjection::Project(camera->viewProjection, mainCamera->extent.max, count, &worlds[0].matrix[3][0],
+        sizeof(WorldTransform) / sizeof(float), screenPositions, clipFlags);
+}
+
 // Protected Fields
 
 // Protected Methods
@@ -253,4 +384,9 @@ const Vec2 Transform::GetScreenPosition(const Transform* const cameraTransform,
 
 // Private Methods
 
+bool Transform::HasLocalChanged(const WorldTransform& world) const
+{
+    return world.version == 0 || !(world.position == position) || world.rotation != rotation || !(world.scale == scale);
+}
+
 } // namespace velecs
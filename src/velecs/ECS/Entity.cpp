@@ -56,8 +56,6 @@ flecs::entity Entity::Create
     flecs::world& world = ecs();
     flecs::entity entity = world.entity();
 
-    transform.entity = entity;
-
     entity.set_override<Transform>(transform);
 
     if (parent)
@@ -79,7 +77,7 @@ flecs::entity Entity::Create
     Transform transform;
 
     transform.position = pos.value_or(Vec3::ZERO);
-    transform.rotation = rot.value_or(Vec3::ZERO);
+    transform.SetEulerAngles(rot.value_or(Vec3::ZERO));
     transform.scale = scale.value_or(Vec3::ONE);
 
     return Create(transform, parent);
@@ -122,7 +120,14 @@ flecs::entity Entity::CreateFromPrefab
     Transform transform;
 
     transform.position = pos.value_or(prefabTransform->position);
-    transform.rotation = rot.value_or(prefabTransform->rotation);
+    if (rot)
+    {
+        transform.SetEulerAngles(rot.value());
+    }
+    else
+    {
+        transform.SetRotation(prefabTransform->GetRotation());
+    }
     transform.scale = scale.value_or(prefabTransform->scale);
 
     return CreateFromPrefab(prefab, transform, parent);;
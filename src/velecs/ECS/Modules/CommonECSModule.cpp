@@ -10,7 +10,12 @@
 
 #include "velecs/ECS/Modules/CommonECSModule.h"
 
+#include "velecs/ECS/Components/PipelineStages.h"
+
+#include "velecs/ECS/TransformPropagation.h"
+
 #include <iostream>
+#include <stdexcept>
 
 namespace velecs {
 
@@ -23,7 +28,8 @@ CommonECSModule::CommonECSModule(flecs::world& ecs)
     ecs.import<CommonECSModule>();
     std::cout << "[INFO] [ECSManager] Started import of '" << typeid(CommonECSModule).name() << "' ECS module on flecs::world::id(): " << ecs.id() << " @ 0x" << ecs.c_ptr() << '.' << std::endl;
 
-    ecs.component<Transform>();
+    _jobSystem = std::make_unique<JobSystem>();
+    InitTransformPropagation(ecs, ecs.get<PipelineStages>()->TransformPropagation, _jobSystem.get());
     
     Entity::Init(ecs);
     Prefab::Init(ecs);
@@ -31,6 +37,40 @@ CommonECSModule::CommonECSModule(flecs::world& ecs)
 
 // Public Methods
 
+flecs::system CommonECSModule::InitTransformPropagation(flecs::world& ecs, const flecs::entity phase, JobSystem* const jobSystem /* = nullptr */)
+{
+    //every Transform carries its cached world matrices
+    ecs.component<WorldTransform>();
+    ecs.component<Transform>().add(flecs::With, ecs.component<WorldTransform>());
+
+    //owned by the system, it lives as long as the world does
+    const std::shared_ptr<TransformPropagation> propagation = std::make_shared<TransformPropagation>(ecs, jobSystem);
+
+    //the transforms are visited through the propagation's own query, read and write only declare the access to the scheduler,
+    //they match no table so the system still runs once per frame
+    return ecs.system("PropagateTransforms")
+        .kind(phase)
+        .read<Transform>()
+        .write<WorldTransform>()
+        .iter([propagation](flecs::iter& it)
+            {
+                propagation->Run();
+            }
+        );
+}
+
+JobSystem& CommonECSModule::GetJobSystem(flecs::world& ecs)
+{
+    //flecs stores the module instance as a component of the module entity
+    const flecs::entity moduleEntity = ecs.lookup("velecs::CommonECSModule");
+    const CommonECSModule* const module = moduleEntity != flecs::entity::null() ? moduleEntity.get<CommonECSModule>() : nullptr;
+    if (module == nullptr || module->_jobSystem == nullptr)
+    {
+        throw std::runtime_error("The CommonECSModule must be imported before its job system is used.");
+    }
+    return *module->_jobSystem;
+}
+
 // Protected Fields
 
 // Protected Methods
@@ -18,6 +18,7 @@
 #include "velecs/ECS/Components/PipelineStages.h"
 
 #include "velecs/Math/Vec3.h"
+#include "velecs/Math/GLMUtility.h"
 
 namespace velecs {
 
@@ -59,7 +60,8 @@ PhysicsECSModule::PhysicsECSModule(flecs::world& ecs)
                     AngularKinematics& angular = angulars[i];
 
                     angular.angularVelocity += angular.angularAcceleration * deltaTime * deltaTime;
-                    transform.rotation += angular.angularVelocity * deltaTime;
+                    //turned about the local axes, adding to the Euler angles would flip once Y passes 90 degrees
+                    transform.SetRotation(transform.GetRotation() * GLMUtility::EulerToQuat(glm::vec3(angular.angularVelocity * deltaTime)));
                 }
             }
     );
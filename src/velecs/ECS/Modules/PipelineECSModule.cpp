@@ -30,7 +30,8 @@ PipelineECSModule::PipelineECSModule(flecs::world& ecs)
     flecs::entity inputUpdate = ecs.entity("InputUpdatePhase").add(flecs::Final).add(flecs::Phase);
     flecs::entity update = ecs.entity("UpdatePhase").add(flecs::Final).add(flecs::Phase).depends_on(inputUpdate);
     flecs::entity collisions = ecs.entity("CollisionsPhase").add(flecs::Final).add(flecs::Phase).depends_on(update);
-    flecs::entity preDraw = ecs.entity("PreDrawPhase").add(flecs::Final).add(flecs::Phase).depends_on(collisions);
+    flecs::entity transformPropagation = ecs.entity("TransformPropagationPhase").add(flecs::Final).add(flecs::Phase).depends_on(collisions);
+    flecs::entity preDraw = ecs.entity("PreDrawPhase").add(flecs::Final).add(flecs::Phase).depends_on(transformPropagation);
     flecs::entity draw = ecs.entity("DrawPhase").add(flecs::Final).add(flecs::Phase).depends_on(preDraw);
     flecs::entity postDraw = ecs.entity("PostDrawPhase").add(flecs::Final).add(flecs::Phase).depends_on(draw);
     flecs::entity housekeeping = ecs.entity("HousekeepingPhase").add(flecs::Final).add(flecs::Phase).depends_on(postDraw);
@@ -43,6 +44,7 @@ PipelineECSModule::PipelineECSModule(flecs::world& ecs)
             inputUpdate,
             update,
             collisions,
+            transformPropagation,
             preDraw,
             draw,
             postDraw,
@@ -17,15 +17,21 @@
 
 #include "velecs/Memory/AllocatedBuffer.h"
 #include "velecs/Engine/vk_initializers.h"
-#include "velecs/Rendering/ShaderModule.h"
 #include "velecs/Rendering/PipelineBuilder.h"
+#include "velecs/Rendering/PipelineRegistry.h"
 #include "velecs/Rendering/MeshPushConstants.h"
+#include "velecs/Rendering/InstanceData.h"
+#include "velecs/Rendering/QuantizedSimpleVertex.h"
+#include "velecs/Math/Frustum.h"
 #include "velecs/Graphics/Color32.h"
 #include "velecs/FileManagement/Path.h"
 
 #include <iostream>
 #include <fstream>
 #include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <array>
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_vulkan.h>
@@ -64,24 +70,55 @@ RenderingECSModule::RenderingECSModule(flecs::world& ecs)
     ecs.import<PhysicsECSModule>();
     ecs.import<InputECSModule>();
 
+    ecs.component<RenderSettings>();
+    if (const RenderSettings* const settings = ecs.get<RenderSettings>())
+    {
+        _settings = *settings;
+    }
+    _settings.framesInFlight = std::clamp(_settings.framesInFlight, 1u, RenderSettings::MAX_FRAMES_IN_FLIGHT);
+    _headless = _settings.headless;
+    if (_headless)
+    {
+        windowExtent = { std::max(_settings.headlessWidth, 1u), std::max(_settings.headlessHeight, 1u) };
+    }
+    _frames.resize(_settings.framesInFlight);
+    _framePacer.Init(_settings.framesInFlight);
+
+    _jobSystem = &CommonECSModule::GetJobSystem(ecs);
+
     InitWindow();
 
     InitVulkan();
-    InitSwapchain();
+    if (!InitSwapchain())
+    {
+        throw std::runtime_error("Failed to create the swapchain.");
+    }
     InitCommands();
     InitDefaultRenderPass();
     InitFrameBuffers();
     InitSyncStructures();
+    InitDescriptors();
+    InitPipelineCache();
+    InitMeshArena();
+    InitGPUCulling();
+    InitGPUProfiler();
     InitPipelines();
 
     InitImGui();
 
     ecs.component<Transform>();
     ecs.component<Mesh>();
-    ecs.component<SimpleMesh>();
+    ecs.component<SimpleMesh>()
+        .on_remove([](SimpleMesh& mesh)
+            {
+                //overwriting a mesh releases its range in the assignment, removing it never reaches one
+                mesh.ReleaseRange();
+            }
+        );
     ecs.component<Material>();
+    ecs.component<CameraData>();
 
-    const Material* const simpleMeshUnlit = Material::Create(ecs, "SimpleMesh/Color", &simpleMeshPipeline, &simpleMeshPipelineLayout);
+    const Material* const simpleMeshUnlit = Material::Create(ecs, "SimpleMesh/Color", &simpleMeshPipeline, &simpleMeshPipelineLayout, Color32::MAGENTA, &simpleMeshInstancedPipeline, &simpleMeshIndirectPipeline);
 
     flecs::entity trianglePrefab = Prefab::Create("PR_TriangleRender")
         .set<SimpleMesh>(SimpleMesh::EQUILATERAL_TRIANGLE())
@@ -102,6 +139,93 @@ RenderingECSModule::RenderingECSModule(flecs::world& ecs)
         }
     );
 
+    // gathers the GPU-driven entities, their culling runs on the GPU before the main render pass begins
+    ecs.system<const WorldTransform, SimpleMesh, Material>()
+        .kind(stages->PreDraw)
+        .iter([this](flecs::iter& it, const WorldTransform* worlds, SimpleMesh* meshes, Material* materials)
+        {
+            if (!_gpuDriven)
+            {
+                return;
+            }
+
+            if (_cameraData.perspective == 0)
+            {
+                return; // only the perspective path is GPU-driven
+            }
+
+            //entities instantiated from a prefab all share one batch per level of detail, look each up once per table
+            const bool sharedBatch = !it.is_self(2) && !it.is_self(3);
+            std::array<uint32_t, SimpleMesh::MAX_LODS> tableBatches;
+            tableBatches.fill(UINT32_MAX);
+
+            _gpuCulling.ReserveObjects((uint32_t)it.count());
+
+            for (auto i : it)
+            {
+                SimpleMesh& mesh = it.is_self(2) ? meshes[i] : meshes[0];
+                const Material& material = it.is_self(3) ? materials[i] : materials[0];
+
+                if (mesh._vertices.empty() || mesh._indices.empty() || !IsGPUDriven(material))
+                {
+                    continue;
+                }
+
+                if (!mesh._range.IsValid())
+                {
+                    UploadMesh(mesh);
+                    continue; // drawn once the upload has retired
+                }
+
+                if (!_meshUploader.IsComplete(mesh._uploadTicket))
+                {
+                    continue; // upload still in flight
+                }
+
+                //refreshed by the TransformPropagation stage right before
+                const glm::mat4& world = worlds[i].matrix;
+                const uint32_t lod = SelectLOD(mesh, world);
+                _renderStats.simplified += lod != 0 ? 1 : 0;
+
+                uint32_t batch = tableBatches[lod];
+                if (batch == UINT32_MAX)
+                {
+                    batch = _gpuCulling.GetBatch(*material.indirectPipeline, mesh, lod);
+                    if (sharedBatch)
+                    {
+                        tableBatches[lod] = batch;
+                    }
+                }
+
+                if (_settings.quantizePositions)
+                {
+                    //the culling transforms the bounds with the object's matrix, express them in quantized space too
+                    const glm::vec4& dequantization = mesh._positionDequantization;
+                    const BoundingSphere quantizedSphere((mesh._boundingSphere.center - glm::vec3(dequantization)) / dequantization.w, mesh._boundingSphere.radius / dequantization.w);
+                    _gpuCulling.AddObject(batch, world * QuantizedSimpleVertex::GetDequantizationMatrix(dequantization), material.color, quantizedSphere);
+                }
+                else
+                {
+                    _gpuCulling.AddObject(batch, world, material.color, mesh._boundingSphere);
+                }
+            }
+        }
+    );
+
+    ecs.system()
+        .kind(stages->PreDraw)
+        .iter([this](flecs::iter& it)
+        {
+            if (_frameSkipped)
+            {
+                return;
+            }
+
+            RecordGPUCulling();
+            BeginMainRenderPass();
+        }
+    );
+
     ecs.system()
         .kind(stages->PostDraw)
         .iter([this](flecs::iter& it)
@@ -118,71 +242,99 @@ RenderingECSModule::RenderingECSModule(flecs::world& ecs)
                 // ImGui::ShowDemoWindow(); // Show demo window! :)
 
                 DisplayFPSCounter();
+                DisplayRenderStats();
+                DisplayGPUProfiler();
+                DisplayPresentSettings();
             }
         );
 
-    ecs.system<Transform, SimpleMesh, Material>()
+    ecs.system<const WorldTransform, SimpleMesh, Material>()
         .kind(stages->Draw)
-        .iter([this](flecs::iter& it, Transform* transforms, SimpleMesh* meshes, Material* materials)
+        .iter([this](flecs::iter& it, const WorldTransform* worlds, SimpleMesh* meshes, Material* materials)
         {
-            float deltaTime = it.delta_time();
+            // computed once per frame by UpdateCameraData, the frustum is in world space
+            const CameraData& camera = _cameraData;
+            const bool usingPerspective = camera.perspective != 0;
 
-            const auto mainCameraEntity = it.world().singleton<MainCamera>();
-            const auto cameraEntity = mainCameraEntity.get<MainCamera>()->camera;
-            const auto cameraTransform = cameraEntity.get<Transform>();
-
-            const PerspectiveCamera* perspectiveCamera;
-            const OrthoCamera* orthoCamera;
-            bool usingPerspective = true;
-
-            if (cameraEntity.has<PerspectiveCamera>())
-            {
-                perspectiveCamera = cameraEntity.get<PerspectiveCamera>();
-                usingPerspective = true;
-            }
-            else if (cameraEntity.has<OrthoCamera>())
+            // a material shared through a prefab decides for the whole table
+            if (!it.is_self(3) && IsGPUDriven(materials[0]))
             {
-                orthoCamera = cameraEntity.get<OrthoCamera>();
-                usingPerspective = false;
-            }
-            else
-            {
-                throw std::runtime_error("MainCamera singleton is missing a PerspectiveCamera or OrthoCamera component.");
+                return; // culled and drawn by the GPUCullingPass
             }
 
             for (auto i : it)
             {
-                const Transform& transform = transforms[i];
-                SimpleMesh& mesh = meshes[i];
-                const Material& material = materials[i];
+                // meshes and materials are usually inherited from a prefab, in which case the field holds a single element
+                SimpleMesh& mesh = it.is_self(2) ? meshes[i] : meshes[0];
+                const Material& material = it.is_self(3) ? materials[i] : materials[0];
                 const flecs::entity entity = it.entity(i);
 
-                if (mesh._vertices.empty() || material.pipeline == VK_NULL_HANDLE || material.pipelineLayout == VK_NULL_HANDLE)
+                if (mesh._vertices.empty() || mesh._indices.empty() || material.pipeline == VK_NULL_HANDLE || material.pipelineLayout == VK_NULL_HANDLE)
                 {
                     continue; // Not enough data to render? Skip entity
                 }
 
-                if (!mesh._vertexBuffer.IsInitialized())
+                if (IsGPUDriven(material))
                 {
-                    UploadMesh(mesh);
+                    continue; // culled and drawn by the GPUCullingPass
                 }
 
-                if (currentPipeline != *material.pipeline)
+                if (!usingPerspective)
                 {
-                    BindPipeline(material);
+                    // Draw(deltaTime, cameraEntity, orthoCamera, cameraTransform, entity, transform, mesh, material);
+                    continue;
                 }
 
-                if (usingPerspective)
+                //cull before anything is uploaded or recorded, the sphere is cheaper and rejects most entities
+                const glm::mat4& world = worlds[i].matrix;
+                if (!camera.frustum.Intersects(mesh._boundingSphere.Transform(world)) || !camera.frustum.Intersects(mesh._bounds.Transform(world)))
                 {
-                    const glm::mat4 renderMatrix = transform.GetRenderMatrix(cameraTransform, perspectiveCamera);
-                    Draw(deltaTime, renderMatrix, mesh, material);
+                    ++_renderStats.culled;
+                    continue;
                 }
-                else
+
+                if (!mesh._range.IsValid())
                 {
-                    const auto orthoCamera = cameraEntity.get<OrthoCamera>();
-                    // Draw(deltaTime, cameraEntity, orthoCamera, cameraTransform, entity, transform, mesh, material);
+                    UploadMesh(mesh);
+                    continue; // drawn once the upload has retired
                 }
+
+                if (!_meshUploader.IsComplete(mesh._uploadTicket))
+                {
+                    continue; // upload still in flight
+                }
+
+                const bool instanced = material.instancedPipeline != nullptr && *material.instancedPipeline != VK_NULL_HANDLE;
+
+                DrawCommand command;
+                command.modelMatrix = _settings.quantizePositions ? world * QuantizedSimpleVertex::GetDequantizationMatrix(mesh._positionDequantization) : world;
+                command.color = material.color;
+                command.mesh = &mesh;
+                command.lod = SelectLOD(mesh, world);
+                command.pipeline = instanced ? *material.instancedPipeline : *material.pipeline;
+                command.pipelineLayout = *material.pipelineLayout;
+                command.instanced = instanced;
+
+                //clip space w of the origin is the distance along the view direction
+                const float viewDepth = camera.GetViewDepth(world[3]);
+                _renderQueue.Push(command, viewDepth / camera.farPlane);
+                _renderStats.simplified += command.lod != 0 ? 1 : 0;
+            }
+        }
+    );
+
+    // runs after every table of the draw system above has been extracted into the render queue
+    ecs.system()
+        .kind(stages->Draw)
+        .iter([this](flecs::iter& it)
+        {
+            if (_frameSkipped)
+            {
+                return;
             }
+
+            SubmitRenderQueue();
+            SubmitGPUDrivenDraws();
         }
     );
 
@@ -209,16 +361,49 @@ RenderingECSModule::RenderingECSModule(flecs::world& ecs)
             [this](flecs::iter& it)
             {
                 flecs::world ecs = it.world();
+
+                //benchmark runs stop by themselves once they rendered the requested frames
+                if (_headless && _settings.headlessFrameCount != 0 && (uint32_t)_frameNumber >= _settings.headlessFrameCount && !ecs.get<Input>()->isQuitting)
+                {
+                    ecs.get_mut<Input>()->isQuitting = true;
+
+                    const float seconds = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - _headlessStart).count();
+                    std::cout << "[INFO] Headless: rendered " << _frameNumber << " frames in " << seconds << " s ("
+                        << (seconds > 0.0f ? _frameNumber / seconds : 0.0f) << " fps)." << std::endl;
+                    if (_gpuProfiler.IsSupported())
+                    {
+                        _gpuProfiler.Log(std::cout);
+                    }
+                }
+
                 const Input* const input = ecs.get<Input>();
                 if (input->isQuitting)
                 {
                     PipelineStages* const pipelineStages = ecs.get_mut<PipelineStages>();
                     pipelineStages->FinalCleanup.add(flecs::Phase).depends_on(pipelineStages->Housekeeping);
-                    vkWaitForFences(_device, 1, &_renderFence, true, 1000000000);
+                    WaitForAllFrames();
                 }
             }
         );
 
+    ecs.system()
+        .kind(stages->Housekeeping)
+        .iter([this](flecs::iter& it)
+        {
+            if (_settings.lowLatency && !_headless && _frameNumber > 0)
+            {
+                //keep no frame queued: wait for the one just submitted, then until the next one can finish just in time
+                const int submittedFrame = _frameNumber - 1;
+                VK_CHECK(vkWaitForFences(_device, 1, &_frames[submittedFrame % _frames.size()]._renderFence, true, 1000000000));
+                _framePacer.OnFrameCompleted(submittedFrame);
+                _framePacer.WaitForInputSample();
+            }
+
+            //the input of the next frame is polled right after this phase
+            _framePacer.OnInputSampled(_frameNumber);
+        }
+    );
+
     ecs.system<Material>()
         .kind(stages->FinalCleanup)
         .iter
@@ -238,24 +423,39 @@ RenderingECSModule::RenderingECSModule(flecs::world& ecs)
 RenderingECSModule::~RenderingECSModule()
 {
     // make sure the GPU has stopped doing its things
-    vkWaitForFences(_device, 1, &_renderFence, true, 1000000000);
+    WaitForAllFrames();
 
     CleanupImGui();
 
+    for (FrameData& frame : _frames)
+    {
+        frame._deletionQueue.Flush();
+
+        if (frame._instanceBuffer.IsInitialized())
+        {
+            vmaDestroyBuffer(_allocator, frame._instanceBuffer._buffer, frame._instanceBuffer._allocation);
+        }
+    }
+
     _mainDeletionQueue.Flush();
 
     CleanupFrameBuffers();
     CleanupSwapchain();
 
     vkDestroyRenderPass(_device, _renderPass, nullptr);
-    vkDestroyCommandPool(_device, _commandPool, nullptr);
 
     vmaDestroyAllocator(_allocator);
     vkDestroyDevice(_device, nullptr);
-    vkDestroySurfaceKHR(_instance, _surface, nullptr);
+    if (_surface != VK_NULL_HANDLE)
+    {
+        vkDestroySurfaceKHR(_instance, _surface, nullptr);
+    }
     vkb::destroy_debug_utils_messenger(_instance, _debug_messenger);
     vkDestroyInstance(_instance, nullptr);
-    SDL_DestroyWindow(_window);
+    if (_window != nullptr)
+    {
+        SDL_DestroyWindow(_window);
+    }
 }
 
 // Public Methods
@@ -289,6 +489,19 @@ void RenderingECSModule::OnWindowMinimize() const
 
 void RenderingECSModule::OnWindowResize()
 {
+    if (_headless)
+    {
+        return; // the offscreen image keeps the size it was created with
+    }
+
+    //dragging a window edge sends a burst of events, only the size at the start of the next frame matters
+    _swapchainDirty = true;
+}
+
+void RenderingECSModule::RecreateSwapchain()
+{
+    _swapchainDirty = false;
+
     int width, height;
     SDL_GetWindowSize(_window, &width, &height);
     while (width == 0 || height == 0)
@@ -310,18 +523,62 @@ void RenderingECSModule::OnWindowResize()
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
 
-    vkDeviceWaitIdle(_device);
+    //frames in flight may still render into the old images, take ownership of them instead of draining the GPU
+    const VkSwapchainKHR oldSwapchain = _swapchain;
+    const std::vector<VkImageView> oldImageViews = _swapchainImageViews;
+    const std::vector<VkFramebuffer> oldFramebuffers = _framebuffers;
+    const VkImageView oldDepthImageView = _depthImageView;
+    const AllocatedImage oldDepthImage = _depthImage;
 
-    CleanupFrameBuffers();
-    CleanupSwapchain();
+    //handed to the deletor below, a failed rebuild must not queue it again on the next attempt
+    _swapchain = VK_NULL_HANDLE;
+    _swapchainImageViews.clear();
+    _framebuffers.clear();
+    _depthImageView = VK_NULL_HANDLE;
+    _depthImage = AllocatedImage();
 
     windowExtent.width = width;
     windowExtent.height = height;
-    
-    ecs().get_mut<MainCamera>()->extent = GetWindowExtent();
 
-    InitSwapchain();
-    InitFrameBuffers();
+    //the old swapchain is retired by the new one, its images are released as their presents complete
+    if (InitSwapchain(oldSwapchain))
+    {
+        InitFrameBuffers();
+        ImGui_ImplVulkan_SetMinImageCount(std::max(2u, (uint32_t)_swapchainImages.size()));
+
+        ecs().get_mut<MainCamera>()->extent = GetWindowExtent();
+
+        //the new depth image holds nothing to cull against until the next frame has rendered into it
+        _depthHistoryValid = false;
+        if (_gpuCulling.IsOcclusionEnabled())
+        {
+            _depthPyramid.Resize(_depthImageView, windowExtent, GetCurrentFrame()._deletionQueue);
+        }
+    }
+    else
+    {
+        //frames are skipped until a later attempt succeeds
+        _swapchainDirty = true;
+    }
+
+    //the current frame's fence was just waited on, its next wait covers every submission that used the old resources
+    GetCurrentFrame()._deletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            for (VkFramebuffer framebuffer : oldFramebuffers)
+            {
+                vkDestroyFramebuffer(_device, framebuffer, nullptr);
+            }
+            for (VkImageView imageView : oldImageViews)
+            {
+                vkDestroyImageView(_device, imageView, nullptr);
+            }
+            vkDestroyImageView(_device, oldDepthImageView, nullptr);
+            vmaDestroyImage(_allocator, oldDepthImage._image, oldDepthImage._allocation);
+            vkDestroySwapchainKHR(_device, oldSwapchain, nullptr);
+        }
+    );
 }
 
 flecs::entity RenderingECSModule::CreatePerspectiveCamera
@@ -339,7 +596,7 @@ flecs::entity RenderingECSModule::CreatePerspectiveCamera
         .override<Transform>()
         .set_override<PerspectiveCamera>({aspectRatio, verticalFOV, nearPlaneOffset, farPlaneOffset});
     
-    camEntity.set<Transform>({camEntity, position, rotation});
+    camEntity.set<Transform>({position, rotation});
 
     return camEntity;
 }
@@ -358,7 +615,7 @@ flecs::entity RenderingECSModule::CreateOrthoCamera
         .override<Transform>()
         .set_override<OrthoCamera>({extent, nearPlaneOffset, farPlaneOffset});
 
-    camEntity.set<Transform>({camEntity, position, rotation});
+    camEntity.set<Transform>({position, rotation});
 
     return camEntity;
 }
@@ -395,6 +652,11 @@ const Rect RenderingECSModule::GetWindowExtent() const
 
 void RenderingECSModule::InitWindow()
 {
+    if (_headless)
+    {
+        return; // nothing to show, there may not even be a display
+    }
+
     // We initialize SDL and create a window with it. 
     SDL_Init(SDL_INIT_VIDEO);
 
@@ -435,7 +697,9 @@ void RenderingECSModule::InitVulkan()
     auto inst_ret = builder.set_app_name("Harvest Havoc")
             .request_validation_layers(enableValidationLayers)
             .require_api_version(1, 1, 0)
+            .desire_api_version(1, 2, 0) // vkCmdDrawIndexedIndirectCount is core in 1.2
             .use_default_debug_messenger()
+            .set_headless(_headless) // no surface extensions, works on software ICDs without a display
             .build();
 
     // Check if instance creation was successful before proceeding
@@ -474,7 +738,7 @@ void RenderingECSModule::InitVulkan()
     }
 
     // get the surface of the window we opened with SDL
-    if (!SDL_Vulkan_CreateSurface(_window, _instance, &_surface))
+    if (!_headless && !SDL_Vulkan_CreateSurface(_window, _instance, &_surface))
     {
         std::cerr << "Failed to create Vulkan surface. SDL Error: " << SDL_GetError() << "\n";
         exit(EXIT_FAILURE);
@@ -488,11 +752,17 @@ void RenderingECSModule::InitVulkan()
     VkPhysicalDeviceFeatures desiredFeatures = {};
     desiredFeatures.fillModeNonSolid = VK_TRUE;
 
-    auto phys_ret = selector
+    selector
         .set_minimum_version(1, 1)
-        .set_surface(_surface)
-        .set_required_features(desiredFeatures)
-        .select();
+        .set_required_features(desiredFeatures);
+
+    //a headless instance makes the selector skip the present support checks
+    if (!_headless)
+    {
+        selector.set_surface(_surface);
+    }
+
+    auto phys_ret = selector.select();
 
     // Check if physical device selection was successful before proceeding
     if (!phys_ret)
@@ -502,8 +772,36 @@ void RenderingECSModule::InitVulkan()
     }
     vkb::PhysicalDevice physicalDevice = phys_ret.value();
 
+    //the GPU-driven path uses these when present and falls back to plainer indirect draws otherwise
+    VkPhysicalDeviceFeatures supportedFeatures = {};
+    vkGetPhysicalDeviceFeatures(physicalDevice.physical_device, &supportedFeatures);
+    _multiDrawIndirect = supportedFeatures.multiDrawIndirect == VK_TRUE;
+    physicalDevice.features.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+
+    uint32_t instanceVersion = VK_API_VERSION_1_0;
+    vkEnumerateInstanceVersion(&instanceVersion);
+    const bool supportsVulkan12 = instanceVersion >= VK_API_VERSION_1_2 && physicalDevice.properties.apiVersion >= VK_API_VERSION_1_2;
+
+    VkPhysicalDeviceVulkan12Features supportedFeatures12 = {};
+    supportedFeatures12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    if (supportsVulkan12)
+    {
+        VkPhysicalDeviceFeatures2 supportedFeatures2 = {};
+        supportedFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        supportedFeatures2.pNext = &supportedFeatures12;
+        vkGetPhysicalDeviceFeatures2(physicalDevice.physical_device, &supportedFeatures2);
+    }
+
+    VkPhysicalDeviceVulkan12Features enabledFeatures12 = {};
+    enabledFeatures12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    enabledFeatures12.drawIndirectCount = supportedFeatures12.drawIndirectCount;
+
     //create the final Vulkan device
     vkb::DeviceBuilder deviceBuilder{ physicalDevice };
+    if (supportsVulkan12)
+    {
+        deviceBuilder.add_pNext(&enabledFeatures12);
+    }
     // automatically propagate needed data from instance & physical device
     auto dev_ret = deviceBuilder.build();
     if (!dev_ret)
@@ -518,10 +816,37 @@ void RenderingECSModule::InitVulkan()
     _device = vkbDevice.device;
     _chosenGPU = physicalDevice.physical_device;
 
+    if (enabledFeatures12.drawIndirectCount == VK_TRUE)
+    {
+        _drawIndexedIndirectCount = (PFN_vkCmdDrawIndexedIndirectCount)vkGetDeviceProcAddr(_device, "vkCmdDrawIndexedIndirectCount");
+    }
+
     // use vkbootstrap to get a Graphics queue
     _graphicsQueue = vkbDevice.get_queue(vkb::QueueType::graphics).value();
     _graphicsQueueFamily = vkbDevice.get_queue_index(vkb::QueueType::graphics).value();
 
+    // prefer a dedicated transfer queue so uploads run alongside rendering instead of in between
+    auto transferQueueRet = vkbDevice.get_dedicated_queue(vkb::QueueType::transfer);
+    if (transferQueueRet)
+    {
+        _transferQueue = transferQueueRet.value();
+        _transferQueueFamily = vkbDevice.get_dedicated_queue_index(vkb::QueueType::transfer).value();
+    }
+    else
+    {
+        _transferQueue = _graphicsQueue;
+        _transferQueueFamily = _graphicsQueueFamily;
+    }
+
+    //the culling dispatches are recorded into the graphics command buffer
+    const std::vector<VkQueueFamilyProperties> queueFamilies = physicalDevice.get_queue_families();
+    const bool graphicsQueueHasCompute = (queueFamilies[_graphicsQueueFamily].queueFlags & VK_QUEUE_COMPUTE_BIT) != 0;
+    _gpuDriven = _settings.gpuDrivenRendering && graphicsQueueHasCompute;
+
+    std::cout << "[INFO] GPU-driven rendering: " << (_gpuDriven ? "on" : "off")
+        << "; draw indirect count: " << (_drawIndexedIndirectCount != nullptr ? "yes" : "no")
+        << "; multi draw indirect: " << (_multiDrawIndirect ? "yes" : "no") << std::endl;
+
     //initialize the memory allocator
     VmaAllocatorCreateInfo allocatorInfo = {};
     allocatorInfo.physicalDevice = _chosenGPU;
@@ -530,10 +855,30 @@ void RenderingECSModule::InitVulkan()
     vmaCreateAllocator(&allocatorInfo, &_allocator);
 }
 
-void RenderingECSModule::InitSwapchain()
+bool RenderingECSModule::InitSwapchain(VkSwapchainKHR oldSwapchain /* = VK_NULL_HANDLE*/)
 {
+    if (_headless)
+    {
+        InitOffscreenImage();
+        InitDepthImage();
+        return true;
+    }
+
     vkb::SwapchainBuilder swapchainBuilder = vkb::SwapchainBuilder{_chosenGPU, _device, _surface};
 
+    _presentMode = ChoosePresentMode(_settings.presentMode);
+
+    //two images are enough to never wait on presentation while keeping the fewest frames queued for display
+    uint32_t imageCount = _settings.swapchainImageCount;
+    if (imageCount == 0 && _settings.lowLatency)
+    {
+        imageCount = 2;
+    }
+    if (imageCount != 0)
+    {
+        swapchainBuilder.set_desired_min_image_count(imageCount);
+    }
+
     // use this if u need to test the Color32 struct, otherwise the displayed color will be slightly different, probably brighter.
     VkSurfaceFormatKHR surfaceFormat = {};
     surfaceFormat.colorSpace = VK_COLOR_SPACE_EXTENDED_SRGB_LINEAR_EXT;
@@ -542,6 +887,9 @@ void RenderingECSModule::InitSwapchain()
     vkb::Result<vkb::Swapchain> vkbSwapchainRet = swapchainBuilder
         .set_desired_format(surfaceFormat)
         // .use_default_format_selection()
+        .set_desired_extent(windowExtent.width, windowExtent.height)
+        .set_desired_present_mode(_presentMode)
+        .set_old_swapchain(oldSwapchain)
         .build()
         ;
     
@@ -549,14 +897,16 @@ void RenderingECSModule::InitSwapchain()
     {
         std::cout << vkbSwapchainRet.vk_result() << std::endl;
         std::cout << "Cancelled building swapchain" << std::endl;
-        return;
+        return false;
     }
     
     vkb::Swapchain vkbSwapchain = vkbSwapchainRet.value();
 
-    vkbSwapchain.extent = windowExtent;
-    //use vsync present mode
-    vkbSwapchain.present_mode = VK_PRESENT_MODE_FIFO_KHR;
+    //the surface may clamp the requested extent, render at the size the swapchain was actually created with
+    windowExtent = vkbSwapchain.extent;
+    std::cout << "[INFO] Swapchain: " << vkbSwapchain.image_count << " images, " << GetPresentModeName(_presentMode)
+        << (_presentMode != _settings.presentMode ? std::string(" (") + GetPresentModeName(_settings.presentMode) + " is not supported)" : std::string())
+        << (_settings.lowLatency ? ", low latency" : "") << "." << std::endl;
 
     //store swapchain and its related images
     _swapchain = vkbSwapchain.swapchain;
@@ -565,8 +915,102 @@ void RenderingECSModule::InitSwapchain()
 
     _swapchainImageFormat = vkbSwapchain.image_format;
 
+    InitDepthImage();
+    return true;
+}
+
+VkPresentModeKHR RenderingECSModule::ChoosePresentMode(const VkPresentModeKHR requested) const
+{
+    uint32_t modeCount = 0;
+    vkGetPhysicalDeviceSurfacePresentModesKHR(_chosenGPU, _surface, &modeCount, nullptr);
+    std::vector<VkPresentModeKHR> supportedModes(modeCount);
+    vkGetPhysicalDeviceSurfacePresentModesKHR(_chosenGPU, _surface, &modeCount, supportedModes.data());
+
+    //closest first: uncapped modes fall back to each other before vsync, relaxed vsync falls back to vsync
+    std::vector<VkPresentModeKHR> candidates = { requested };
+    switch (requested)
+    {
+        case VK_PRESENT_MODE_IMMEDIATE_KHR:
+            candidates.push_back(VK_PRESENT_MODE_MAILBOX_KHR);
+            break;
+        case VK_PRESENT_MODE_MAILBOX_KHR:
+            candidates.push_back(VK_PRESENT_MODE_IMMEDIATE_KHR);
+            break;
+        default:
+            break;
+    }
+
+    for (const VkPresentModeKHR candidate : candidates)
+    {
+        if (std::find(supportedModes.begin(), supportedModes.end(), candidate) != supportedModes.end())
+        {
+            return candidate;
+        }
+    }
+
+    return VK_PRESENT_MODE_FIFO_KHR; // the only mode every surface has to support
+}
+
+const char* RenderingECSModule::GetPresentModeName(const VkPresentModeKHR presentMode)
+{
+    switch (presentMode)
+    {
+        case VK_PRESENT_MODE_IMMEDIATE_KHR:
+            return "IMMEDIATE";
+        case VK_PRESENT_MODE_MAILBOX_KHR:
+            return "MAILBOX";
+        case VK_PRESENT_MODE_FIFO_KHR:
+            return "FIFO";
+        case VK_PRESENT_MODE_FIFO_RELAXED_KHR:
+            return "FIFO_RELAXED";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+void RenderingECSModule::SetPresentMode(const VkPresentModeKHR presentMode)
+{
+    _settings.presentMode = presentMode;
+    _swapchainDirty = !_headless;
+}
+
+void RenderingECSModule::SetLowLatency(const bool lowLatency)
+{
+    _settings.lowLatency = lowLatency;
+    _swapchainDirty = !_headless; // the default image count depends on it
+}
+
+void RenderingECSModule::InitOffscreenImage()
+{
+    //same format the swapchain is asked for, so the render pass and pipelines are identical in both modes
+    _swapchainImageFormat = VK_FORMAT_B8G8R8A8_UNORM;
+
+    VkExtent3D imageExtent = {
+        windowExtent.width,
+        windowExtent.height,
+        1
+    };
+
+    //rendered into every frame, and copied out by whoever wants to look at the result
+    VkImageCreateInfo img_info = vkinit::image_create_info(_swapchainImageFormat, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, imageExtent);
+
+    VmaAllocationCreateInfo img_allocinfo = {};
+    img_allocinfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
 
+    VK_CHECK(vmaCreateImage(_allocator, &img_info, &img_allocinfo, &_offscreenImage._image, &_offscreenImage._allocation, nullptr));
+
+    VkImageViewCreateInfo view_info = vkinit::imageview_create_info(_swapchainImageFormat, _offscreenImage._image, VK_IMAGE_ASPECT_COLOR_BIT);
+
+    VkImageView imageView = VK_NULL_HANDLE;
+    VK_CHECK(vkCreateImageView(_device, &view_info, nullptr, &imageView));
+
+    //the rest of the renderer sees a swapchain of a single image
+    _swapchainImages = { _offscreenImage._image };
+    _swapchainImageViews = { imageView };
+}
 
+void RenderingECSModule::InitDepthImage()
+{
     //depth image size will match the window
     VkExtent3D depthImageExtent = {
         windowExtent.width,
@@ -578,7 +1022,8 @@ void RenderingECSModule::InitSwapchain()
     _depthFormat = VK_FORMAT_D32_SFLOAT;
 
     //the depth image will be an image with the format we selected and Depth Attachment usage flag
-    VkImageCreateInfo dimg_info = vkinit::image_create_info(_depthFormat, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, depthImageExtent);
+    //sampled by the depth pyramid reduction when occlusion culling is on
+    VkImageCreateInfo dimg_info = vkinit::image_create_info(_depthFormat, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, depthImageExtent);
 
     //for the depth image, we want to allocate it from GPU local memory
     VmaAllocationCreateInfo dimg_allocinfo = {};
@@ -630,6 +1075,14 @@ void RenderingECSModule::CleanupSwapchain()
         vkDestroySwapchainKHR(_device, _swapchain, nullptr);
         _swapchain = VK_NULL_HANDLE; // Reset the swapchain handle
     }
+
+    if (_offscreenImage._image != VK_NULL_HANDLE)
+    {
+        vmaDestroyImage(_allocator, _offscreenImage._image, _offscreenImage._allocation);
+        _offscreenImage._image = VK_NULL_HANDLE;
+        _offscreenImage._allocation = VK_NULL_HANDLE;
+    }
+    _swapchainImages.clear();
 }
 
 void RenderingECSModule::InitCommands()
@@ -638,30 +1091,54 @@ void RenderingECSModule::InitCommands()
     //we also want the pool to allow for resetting of individual command buffers
     VkCommandPoolCreateInfo commandPoolInfo = vkinit::command_pool_create_info(_graphicsQueueFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
 
-    VK_CHECK(vkCreateCommandPool(_device, &commandPoolInfo, nullptr, &_commandPool));
+    for (FrameData& frame : _frames)
+    {
+        VK_CHECK(vkCreateCommandPool(_device, &commandPoolInfo, nullptr, &frame._commandPool));
+
+        //allocate the default command buffer that we will use for rendering
+        VkCommandBufferAllocateInfo cmdAllocInfo = vkinit::command_buffer_allocate_info(frame._commandPool, 1);
 
-    //allocate the default command buffer that we will use for rendering
-    VkCommandBufferAllocateInfo cmdAllocInfo = vkinit::command_buffer_allocate_info(_commandPool, 1);
+        VK_CHECK(vkAllocateCommandBuffers(_device, &cmdAllocInfo, &frame._mainCommandBuffer));
 
-    VK_CHECK(vkAllocateCommandBuffers(_device, &cmdAllocInfo, &_mainCommandBuffer));
+        //the main render pass only executes secondary command buffers, this one holds what the main thread records inside it
+        VkCommandBufferAllocateInfo inlineAllocInfo = vkinit::command_buffer_allocate_info(frame._commandPool, 1, VK_COMMAND_BUFFER_LEVEL_SECONDARY);
 
+        VK_CHECK(vkAllocateCommandBuffers(_device, &inlineAllocInfo, &frame._inlineCommandBuffer));
 
+        _mainDeletionQueue.PushDeletor
+        (
+            [=, commandPool = frame._commandPool]()
+            {
+                vkDestroyCommandPool(_device, commandPool, nullptr);
+            }
+        );
 
-    VkCommandPoolCreateInfo uploadCommandPoolInfo = vkinit::command_pool_create_info(_graphicsQueueFamily);
-    //create pool for upload context
-    VK_CHECK(vkCreateCommandPool(_device, &uploadCommandPoolInfo, nullptr, &_uploadContext._commandPool));
+        //command pools are externally synchronized, every recording thread gets its own
+        VkCommandPoolCreateInfo recordingPoolInfo = vkinit::command_pool_create_info(_graphicsQueueFamily, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
 
-    _mainDeletionQueue.PushDeletor
-    (
-        [=]()
+        //one per recording job, never more jobs than the shared job system has threads
+        const uint32_t threadCount = _settings.recordingThreads == 0
+            ? _jobSystem->GetThreadCount()
+            : std::min(_settings.recordingThreads, _jobSystem->GetThreadCount());
+        frame._recordingCommandPools.resize(threadCount);
+        frame._recordingCommandBuffers.resize(threadCount);
+        for (uint32_t i = 0; i < threadCount; ++i)
         {
-            vkDestroyCommandPool(_device, _uploadContext._commandPool, nullptr);
-        }
-    );
+            VK_CHECK(vkCreateCommandPool(_device, &recordingPoolInfo, nullptr, &frame._recordingCommandPools[i]));
+
+            VkCommandBufferAllocateInfo recordingAllocInfo = vkinit::command_buffer_allocate_info(frame._recordingCommandPools[i], 1, VK_COMMAND_BUFFER_LEVEL_SECONDARY);
 
-    //allocate the default command buffer that we will use for the instant commands
-    VkCommandBufferAllocateInfo cmdAllocInfo2 = vkinit::command_buffer_allocate_info(_uploadContext._commandPool, 1);
-    VK_CHECK(vkAllocateCommandBuffers(_device, &cmdAllocInfo2, &_uploadContext._commandBuffer));
+            VK_CHECK(vkAllocateCommandBuffers(_device, &recordingAllocInfo, &frame._recordingCommandBuffers[i]));
+
+            _mainDeletionQueue.PushDeletor
+            (
+                [=, commandPool = frame._recordingCommandPools[i]]()
+                {
+                    vkDestroyCommandPool(_device, commandPool, nullptr);
+                }
+            );
+        }
+    }
 }
 
 void RenderingECSModule::InitDefaultRenderPass()
@@ -678,6 +1155,10 @@ void RenderingECSModule::InitDefaultRenderPass()
     color_attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE; // we don't care about stencil
     color_attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED; // we don't know nor care about the starting layout of the attachment
     color_attachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR; // after the renderpass ends, the image has to be on a layout ready for display
+    if (_headless)
+    {
+        color_attachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL; // nothing is presented, leave it ready to be copied out
+    }
 
     VkAttachmentReference color_attachment_ref = {};
     color_attachment_ref.attachment = 0; // attachment number will index into the pAttachments array in the parent renderpass itself
@@ -717,7 +1198,8 @@ void RenderingECSModule::InitDefaultRenderPass()
     dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
     dependency.dstSubpass = 0;
     dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    dependency.srcAccessMask = 0;
+    //in headless mode every frame in flight shares the offscreen image, its clear has to wait for the previous frame's color writes
+    dependency.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
     dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
     dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
 
@@ -725,7 +1207,8 @@ void RenderingECSModule::InitDefaultRenderPass()
     depth_dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
     depth_dependency.dstSubpass = 0;
     depth_dependency.srcStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-    depth_dependency.srcAccessMask = 0;
+    //every frame in flight shares the depth image, its clear has to wait for the previous frame's depth writes
+    depth_dependency.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
     depth_dependency.dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
     depth_dependency.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 
@@ -790,33 +1273,240 @@ void RenderingECSModule::InitSyncStructures()
     //we want to create the fence with the Create Signaled flag, so we can wait on it before using it on a GPU command (for the first frame)
     VkFenceCreateInfo fenceCreateInfo = vkinit::fence_create_info(VK_FENCE_CREATE_SIGNALED_BIT);
 
-    VK_CHECK(vkCreateFence(_device, &fenceCreateInfo, nullptr, &_renderFence));
-
-    VkFenceCreateInfo uploadFenceCreateInfo = vkinit::fence_create_info();
-
-    VK_CHECK(vkCreateFence(_device, &uploadFenceCreateInfo, nullptr, &_uploadContext._uploadFence));
-
     //for the semaphores we don't need any flags
     VkSemaphoreCreateInfo semaphoreCreateInfo = vkinit::semaphore_create_info();
 
-    VK_CHECK(vkCreateSemaphore(_device, &semaphoreCreateInfo, nullptr, &_presentSemaphore));
-    VK_CHECK(vkCreateSemaphore(_device, &semaphoreCreateInfo, nullptr, &_renderSemaphore));
+    for (FrameData& frame : _frames)
+    {
+        VK_CHECK(vkCreateFence(_device, &fenceCreateInfo, nullptr, &frame._renderFence));
 
-    _mainDeletionQueue.PushDeletor
-    (
-        [=]()
-        {
-            vkDestroyFence(_device, _uploadContext._uploadFence, nullptr);
-            vkDestroyFence(_device, _renderFence, nullptr);
+        VK_CHECK(vkCreateSemaphore(_device, &semaphoreCreateInfo, nullptr, &frame._presentSemaphore));
+        VK_CHECK(vkCreateSemaphore(_device, &semaphoreCreateInfo, nullptr, &frame._renderSemaphore));
 
-            vkDestroySemaphore(_device, _presentSemaphore, nullptr);
-            vkDestroySemaphore(_device, _renderSemaphore, nullptr);
-        }
-    );
+        _mainDeletionQueue.PushDeletor
+        (
+            [=, renderFence = frame._renderFence, presentSemaphore = frame._presentSemaphore, renderSemaphore = frame._renderSemaphore]()
+            {
+                vkDestroyFence(_device, renderFence, nullptr);
+
+                vkDestroySemaphore(_device, presentSemaphore, nullptr);
+                vkDestroySemaphore(_device, renderSemaphore, nullptr);
+            }
+        );
+    }
 }
 
-void RenderingECSModule::InitPipelines()
+void RenderingECSModule::InitDescriptors()
 {
+    VkDescriptorSetLayoutBinding cameraBinding = {};
+    cameraBinding.binding = 0;
+    cameraBinding.descriptorCount = 1;
+    cameraBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    cameraBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT; // the occlusion culling reads the previous view-projection
+
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo = {};
+    setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setLayoutInfo.pNext = nullptr;
+    setLayoutInfo.bindingCount = 1;
+    setLayoutInfo.pBindings = &cameraBinding;
+
+    VK_CHECK(vkCreateDescriptorSetLayout(_device, &setLayoutInfo, nullptr, &_cameraSetLayout));
+
+    VkDescriptorPoolSize poolSize = { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, (uint32_t)_frames.size() };
+
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.pNext = nullptr;
+    poolInfo.maxSets = (uint32_t)_frames.size();
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+
+    VK_CHECK(vkCreateDescriptorPool(_device, &poolInfo, nullptr, &_descriptorPool));
+
+    for (FrameData& frame : _frames)
+    {
+        VkBufferCreateInfo bufferInfo = {};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.pNext = nullptr;
+        bufferInfo.size = sizeof(CameraData);
+        bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+
+        //rewritten once per frame, keep it persistently mapped
+        VmaAllocationCreateInfo vmaallocInfo = {};
+        vmaallocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+        vmaallocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        VmaAllocationInfo allocationInfo = {};
+        VK_CHECK(vmaCreateBuffer(_allocator, &bufferInfo, &vmaallocInfo,
+            &frame._cameraBuffer._buffer,
+            &frame._cameraBuffer._allocation,
+            &allocationInfo));
+        frame._cameraBufferMapped = allocationInfo.pMappedData;
+
+        VkDescriptorSetAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.pNext = nullptr;
+        allocInfo.descriptorPool = _descriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &_cameraSetLayout;
+
+        VK_CHECK(vkAllocateDescriptorSets(_device, &allocInfo, &frame._cameraDescriptorSet));
+
+        VkDescriptorBufferInfo descriptorBufferInfo = {};
+        descriptorBufferInfo.buffer = frame._cameraBuffer._buffer;
+        descriptorBufferInfo.offset = 0;
+        descriptorBufferInfo.range = sizeof(CameraData);
+
+        VkWriteDescriptorSet write = {};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.pNext = nullptr;
+        write.dstSet = frame._cameraDescriptorSet;
+        write.dstBinding = 0;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        write.pBufferInfo = &descriptorBufferInfo;
+
+        vkUpdateDescriptorSets(_device, 1, &write, 0, nullptr);
+
+        _mainDeletionQueue.PushDeletor
+        (
+            [=, cameraBuffer = frame._cameraBuffer]()
+            {
+                vmaDestroyBuffer(_allocator, cameraBuffer._buffer, cameraBuffer._allocation);
+            }
+        );
+    }
+
+    _mainDeletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            vkDestroyDescriptorPool(_device, _descriptorPool, nullptr);
+            vkDestroyDescriptorSetLayout(_device, _cameraSetLayout, nullptr);
+        }
+    );
+}
+
+void RenderingECSModule::InitPipelineCache()
+{
+    _pipelineCache.Init(_device, _chosenGPU, Path::Combine(Path::GAME_DIR, "pipeline_cache.bin"));
+
+    _mainDeletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            // every pipeline has been created by now, serialize what the driver compiled
+            _pipelineCache.Cleanup();
+        }
+    );
+}
+
+void RenderingECSModule::InitMeshArena()
+{
+    std::vector<uint32_t> queueFamilies{_graphicsQueueFamily};
+    if (_transferQueueFamily != _graphicsQueueFamily)
+    {
+        queueFamilies.push_back(_transferQueueFamily);
+    }
+
+    const uint32_t vertexStride = _settings.quantizePositions ? sizeof(QuantizedSimpleVertex) : sizeof(SimpleVertex);
+    _meshArena.Init(_allocator, vertexStride, _settings.meshArenaVertexCapacity, _settings.meshArenaIndexCapacity, queueFamilies);
+
+    _meshUploader.Init(_device, _allocator, _transferQueue, _transferQueueFamily, &_meshArena, _settings.stagingRingSize, _settings.quantizePositions);
+
+    _mainDeletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            // the uploader waits for its in-flight copies before the arena goes away
+            _meshUploader.Cleanup();
+            _meshArena.Cleanup();
+        }
+    );
+}
+
+void RenderingECSModule::InitGPUCulling()
+{
+    if (!_gpuDriven)
+    {
+        return;
+    }
+
+    VkDescriptorSetLayout depthPyramidSetLayout = VK_NULL_HANDLE;
+    if (_settings.occlusionCulling)
+    {
+        _depthPyramid.Init(_device, _allocator, _pipelineCache.Get());
+        _depthPyramid.Resize(_depthImageView, windowExtent, _mainDeletionQueue);
+        depthPyramidSetLayout = _depthPyramid.GetSetLayout();
+    }
+
+    _gpuCulling.Init(_device, _allocator, (uint32_t)_frames.size(), _drawIndexedIndirectCount, _multiDrawIndirect, _cameraSetLayout, depthPyramidSetLayout, _pipelineCache.Get());
+
+    _mainDeletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            _gpuCulling.Cleanup();
+            _depthPyramid.Cleanup();
+        }
+    );
+}
+
+void RenderingECSModule::InitGPUProfiler()
+{
+    if (!_settings.gpuProfiling)
+    {
+        return;
+    }
+
+    _gpuProfiler.Init(_device, _chosenGPU, _graphicsQueueFamily, (uint32_t)_frames.size());
+    if (!_gpuProfiler.IsSupported())
+    {
+        std::cout << "[INFO] GPU profiling: the graphics queue does not support timestamps." << std::endl;
+    }
+
+    _mainDeletionQueue.PushDeletor
+    (
+        [=]()
+        {
+            _gpuProfiler.Cleanup();
+        }
+    );
+}
+
+const char* RenderingECSModule::GetPipelineName(const VkPipeline pipeline) const
+{
+    const auto it = _pipelineNames.find(pipeline);
+    return it != _pipelineNames.end() ? it->second.c_str() : "Unnamed material";
+}
+
+FrameData& RenderingECSModule::GetCurrentFrame()
+{
+    return _frames[_frameNumber % _frames.size()];
+}
+
+void RenderingECSModule::WaitForAllFrames()
+{
+    std::vector<VkFence> fences;
+    fences.reserve(_frames.size());
+    for (const FrameData& frame : _frames)
+    {
+        if (frame._renderFence != VK_NULL_HANDLE)
+        {
+            fences.push_back(frame._renderFence);
+        }
+    }
+
+    if (!fences.empty())
+    {
+        vkWaitForFences(_device, (uint32_t)fences.size(), fences.data(), true, 1000000000);
+    }
+}
+
+void RenderingECSModule::InitPipelines()
+{
+    const auto pipelinesStart = std::chrono::high_resolution_clock::now();
+
     //build the stage-create-info for both vertex and fragment stages. This lets the pipeline know the shader modules per stage
     PipelineBuilder pipelineBuilder;
 
@@ -860,6 +1550,9 @@ void RenderingECSModule::InitPipelines()
 
 
 
+    //every pipeline is only described here, the registry loads the shaders and creates them all at once at the end
+    PipelineRegistry registry;
+
     //we start from just the default empty pipeline layout info
     VkPipelineLayoutCreateInfo mesh_pipeline_layout_info = vkinit::pipeline_layout_create_info();
 
@@ -875,33 +1568,13 @@ void RenderingECSModule::InitPipelines()
     mesh_pipeline_layout_info.pPushConstantRanges = &push_constant;
     mesh_pipeline_layout_info.pushConstantRangeCount = 1;
 
-    VK_CHECK(vkCreatePipelineLayout(_device, &mesh_pipeline_layout_info, nullptr, &_meshPipelineLayout));
-
-    VertexInputAttributeDescriptor vertexDescription = Vertex::GetVertexDescription();
-
-    //connect the pipeline builder vertex input info to the one we get from Vertex
-    pipelineBuilder._vertexInputInfo.pVertexAttributeDescriptions = vertexDescription.attributes.data();
-    pipelineBuilder._vertexInputInfo.vertexAttributeDescriptionCount = (uint32_t)vertexDescription.attributes.size();
-
-    pipelineBuilder._vertexInputInfo.pVertexBindingDescriptions = vertexDescription.bindings.data();
-    pipelineBuilder._vertexInputInfo.vertexBindingDescriptionCount = (uint32_t)vertexDescription.bindings.size();
-
-    //add the other shaders
-    const ShaderModule meshVertShader = ShaderModule::CreateVertShader(_device, "Mesh/Mesh.vert.spv");
-    pipelineBuilder._shaderStages.push_back(meshVertShader.pipelineShaderStageCreateInfo);
-
-    //make sure that triangleFragShader is holding the compiled colored_triangle.frag
-    const ShaderModule meshFragShader = ShaderModule::CreateFragShader(_device, "Mesh/Mesh.frag.spv");
-    pipelineBuilder._shaderStages.push_back(meshFragShader.pipelineShaderStageCreateInfo);
+    //the camera matrices come from the per-frame CameraData set, push constants only carry the model matrix
+    mesh_pipeline_layout_info.pSetLayouts = &_cameraSetLayout;
+    mesh_pipeline_layout_info.setLayoutCount = 1;
 
-    pipelineBuilder._pipelineLayout = _meshPipelineLayout;
-
-    _meshPipeline = pipelineBuilder.BuildPipeline(_device, _renderPass);
-
-    Material::Create(ecs(), "Mesh/Mesh", &_meshPipeline, &_meshPipelineLayout);
+    VK_CHECK(vkCreatePipelineLayout(_device, &mesh_pipeline_layout_info, nullptr, &_meshPipelineLayout));
 
-    //clear the shader stages for the builder
-    pipelineBuilder._shaderStages.clear();
+    registry.Add(&_meshPipeline, "Mesh/Mesh.vert.spv", "Mesh/Mesh.frag.spv", _meshPipelineLayout, Vertex::GetVertexDescription());
 
     
 
@@ -926,45 +1599,57 @@ void RenderingECSModule::InitPipelines()
     simple_mesh_pipeline_layout_info.pPushConstantRanges = &simple_mesh_push_constant;
     simple_mesh_pipeline_layout_info.pushConstantRangeCount = 1;
 
-    VK_CHECK(vkCreatePipelineLayout(_device, &simple_mesh_pipeline_layout_info, nullptr, &simpleMeshPipelineLayout));
-
-    VertexInputAttributeDescriptor simpleMeshVertexDescription = SimpleVertex::GetVertexDescription();
+    simple_mesh_pipeline_layout_info.pSetLayouts = &_cameraSetLayout;
+    simple_mesh_pipeline_layout_info.setLayoutCount = 1;
 
-    //connect the pipeline builder vertex input info to the one we get from Vertex
-    pipelineBuilder._vertexInputInfo.pVertexAttributeDescriptions = simpleMeshVertexDescription.attributes.data();
-    pipelineBuilder._vertexInputInfo.vertexAttributeDescriptionCount = (uint32_t)simpleMeshVertexDescription.attributes.size();
-
-    pipelineBuilder._vertexInputInfo.pVertexBindingDescriptions = simpleMeshVertexDescription.bindings.data();
-    pipelineBuilder._vertexInputInfo.vertexBindingDescriptionCount = (uint32_t)simpleMeshVertexDescription.bindings.size();
-
-    
-    const ShaderModule simpleMeshVertShader = ShaderModule::CreateVertShader(_device, "SimpleMesh/SolidColor.vert.spv");
-    pipelineBuilder._shaderStages.push_back(simpleMeshVertShader.pipelineShaderStageCreateInfo);
+    VK_CHECK(vkCreatePipelineLayout(_device, &simple_mesh_pipeline_layout_info, nullptr, &simpleMeshPipelineLayout));
 
-    //make sure that triangleFragShader is holding the compiled colored_triangle.frag
-    const ShaderModule simpleMeshFragShader = ShaderModule::CreateFragShader(_device, "SimpleMesh/SolidColor.frag.spv");
-    pipelineBuilder._shaderStages.push_back(simpleMeshFragShader.pipelineShaderStageCreateInfo);
+    //quantized meshes only differ in their vertex input, the dequantization is folded into the model matrix
+    const VertexInputAttributeDescriptor simpleMeshVertexDescription = _settings.quantizePositions ? QuantizedSimpleVertex::GetVertexDescription() : SimpleVertex::GetVertexDescription();
 
-    pipelineBuilder._pipelineLayout = simpleMeshPipelineLayout;
+    registry.Add(&simpleMeshPipeline, "SimpleMesh/SolidColor.vert.spv", "SimpleMesh/SolidColor.frag.spv", simpleMeshPipelineLayout, simpleMeshVertexDescription);
+    registry.Add(&_rainbowSimpleMeshPipeline, "SimpleMesh/Rainbow.vert.spv", "SimpleMesh/Rainbow.frag.spv", simpleMeshPipelineLayout, simpleMeshVertexDescription);
 
-    //build the mesh triangle pipeline
-    simpleMeshPipeline = pipelineBuilder.BuildPipeline(_device, _renderPass);
 
-    Material::Create(ecs(), "SimpleMesh/SolidColor", &simpleMeshPipeline, &simpleMeshPipelineLayout);
 
-    pipelineBuilder._shaderStages.clear();
+    //the instanced variants read their matrix and color from a second, per-instance vertex binding
+    VertexInputAttributeDescriptor instancedSimpleMeshVertexDescription = simpleMeshVertexDescription;
+    InstanceData::AppendVertexDescription(instancedSimpleMeshVertexDescription);
 
+    registry.Add(&simpleMeshInstancedPipeline, "SimpleMesh/SolidColorInstanced.vert.spv", "SimpleMesh/SolidColorInstanced.frag.spv", simpleMeshPipelineLayout, instancedSimpleMeshVertexDescription);
+    registry.Add(&_rainbowSimpleMeshInstancedPipeline, "SimpleMesh/RainbowInstanced.vert.spv", "SimpleMesh/RainbowInstanced.frag.spv", simpleMeshPipelineLayout, instancedSimpleMeshVertexDescription);
 
+    if (_gpuDriven)
+    {
+        //the GPU-driven variants read everything per object from the GPUCullingPass storage buffers
+        const VkPipelineLayout indirectLayout = *_gpuCulling.GetDrawPipelineLayout();
 
-    //add the other shaders
-    const ShaderModule rainbowTriangleVertShader = ShaderModule::CreateVertShader(_device, "SimpleMesh/Rainbow.vert.spv");
-    pipelineBuilder._shaderStages.push_back(rainbowTriangleVertShader.pipelineShaderStageCreateInfo);
-    const ShaderModule rainbowTriangleFragShader = ShaderModule::CreateFragShader(_device, "SimpleMesh/Rainbow.frag.spv");
-    pipelineBuilder._shaderStages.push_back(rainbowTriangleFragShader.pipelineShaderStageCreateInfo);
+        registry.Add(&simpleMeshIndirectPipeline, "SimpleMesh/SolidColorIndirect.vert.spv", "SimpleMesh/SolidColorInstanced.frag.spv", indirectLayout, simpleMeshVertexDescription);
+        registry.Add(&_rainbowSimpleMeshIndirectPipeline, "SimpleMesh/RainbowIndirect.vert.spv", "SimpleMesh/RainbowInstanced.frag.spv", indirectLayout, simpleMeshVertexDescription);
+    }
 
-    _rainbowSimpleMeshPipeline = pipelineBuilder.BuildPipeline(_device, _renderPass);
+    registry.Build(_device, _renderPass, pipelineBuilder, _pipelineCache.Get(), *_jobSystem);
 
-    Material::Create(ecs(), "SimpleMesh/Rainbow", &_rainbowSimpleMeshPipeline, &simpleMeshPipelineLayout);
+    Material::Create(ecs(), "Mesh/Mesh", &_meshPipeline, &_meshPipelineLayout);
+    Material::Create(ecs(), "SimpleMesh/SolidColor", &simpleMeshPipeline, &simpleMeshPipelineLayout, Color32::MAGENTA, &simpleMeshInstancedPipeline, &simpleMeshIndirectPipeline);
+    Material::Create(ecs(), "SimpleMesh/Rainbow", &_rainbowSimpleMeshPipeline, &simpleMeshPipelineLayout, Color32::MAGENTA, &_rainbowSimpleMeshInstancedPipeline, &_rainbowSimpleMeshIndirectPipeline);
+
+    //names of the GPU timing scopes of every material batch
+    _pipelineNames[_meshPipeline] = "Mesh/Mesh";
+    _pipelineNames[simpleMeshPipeline] = "SimpleMesh/SolidColor";
+    _pipelineNames[simpleMeshInstancedPipeline] = "SimpleMesh/SolidColor (instanced)";
+    _pipelineNames[_rainbowSimpleMeshPipeline] = "SimpleMesh/Rainbow";
+    _pipelineNames[_rainbowSimpleMeshInstancedPipeline] = "SimpleMesh/Rainbow (instanced)";
+
+    const float pipelinesMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - pipelinesStart).count();
+    if (_pipelineCache.IsWarm())
+    {
+        std::cout << "[INFO] Created pipelines in " << pipelinesMs << " ms from the pipeline cache (" << _pipelineCache.GetLoadedSize() << " bytes)." << std::endl;
+    }
+    else
+    {
+        std::cout << "[INFO] Created pipelines in " << pipelinesMs << " ms, cold build." << std::endl;
+    }
 }
 
 static void check_vk_result(VkResult err)
@@ -1012,19 +1697,23 @@ void RenderingECSModule::InitImGui()
     // io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;      // Enable Gamepad Controls
     io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;         // IF using Docking Branch
 
-    // Setup Platform/Renderer backends
-    ImGui_ImplSDL2_InitForVulkan(_window);
+    // Setup Platform/Renderer backends, headless mode has no platform and feeds ImGui its display size itself
+    if (!_headless)
+    {
+        ImGui_ImplSDL2_InitForVulkan(_window);
+    }
     ImGui_ImplVulkan_InitInfo init_info = {};
     init_info.Instance = _instance;
     init_info.PhysicalDevice = _chosenGPU;
     init_info.Device = _device;
     init_info.QueueFamily = _graphicsQueueFamily;
     init_info.Queue = _graphicsQueue;
-    // init_info.PipelineCache = YOUR_PIPELINE_CACHE;
+    init_info.PipelineCache = _pipelineCache.Get();
     init_info.DescriptorPool = imguiPool;
     init_info.Subpass = 0;
-    init_info.MinImageCount = 2;
-    init_info.ImageCount = 2;
+    //ImGui keeps a vertex and index buffer per ImageCount, one per frame in flight so none is rewritten while the GPU reads it
+    init_info.MinImageCount = std::max(2u, (uint32_t)_swapchainImages.size());
+    init_info.ImageCount = std::max(init_info.MinImageCount, _settings.framesInFlight);
     init_info.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
     // init_info.Allocator = YOUR_ALLOCATOR;
     init_info.CheckVkResultFn = check_vk_result;
@@ -1034,7 +1723,10 @@ void RenderingECSModule::InitImGui()
 void RenderingECSModule::CleanupImGui()
 {
     ImGui_ImplVulkan_Shutdown();
-    ImGui_ImplSDL2_Shutdown();
+    if (!_headless)
+    {
+        ImGui_ImplSDL2_Shutdown();
+    }
     ImGui::DestroyContext();
 
     vkDestroyDescriptorPool(_device, imguiPool, nullptr);
@@ -1044,18 +1736,100 @@ void RenderingECSModule::PreDrawStep(float deltaTime)
 {
     // Start the Dear ImGui frame
     ImGui_ImplVulkan_NewFrame();
-    ImGui_ImplSDL2_NewFrame();
+    if (_headless)
+    {
+        ImGuiIO& io = ImGui::GetIO();
+        io.DisplaySize = ImVec2((float)windowExtent.width, (float)windowExtent.height);
+        io.DeltaTime = deltaTime > 0.0f ? deltaTime : 1.0f / 60.0f;
+    }
+    else
+    {
+        ImGui_ImplSDL2_NewFrame();
+    }
     ImGui::NewFrame();
 
-    //wait until the GPU has finished rendering the last frame. Timeout of 1 second
-    VK_CHECK(vkWaitForFences(_device, 1, &_renderFence, true, 1000000000));
-    VK_CHECK(vkResetFences(_device, 1, &_renderFence));
+    FrameData& frame = GetCurrentFrame();
 
-    //request image from the swapchain, one second timeout
-    VK_CHECK(vkAcquireNextImageKHR(_device, _swapchain, 1000000000, _presentSemaphore, nullptr, &swapchainImageIndex));
+    //wait until the GPU has finished rendering the last frame that used this context. Timeout of 1 second
+    VK_CHECK(vkWaitForFences(_device, 1, &frame._renderFence, true, 1000000000));
+    VK_CHECK(vkResetFences(_device, 1, &frame._renderFence));
+
+    //without low latency pacing, the previous use of this context is only known complete here
+    if (_frameNumber >= (int)_frames.size())
+    {
+        _framePacer.OnFrameCompleted(_frameNumber - (int)_frames.size());
+    }
+
+    //everything deferred by this context's previous use is no longer referenced by the GPU
+    frame._deletionQueue.Flush();
+
+    //meshes whose upload finished since last frame become drawable
+    _meshUploader.Poll();
+
+    if (_headless)
+    {
+        //there is a single offscreen image, the render pass' color dependency orders its reuse across frames in flight
+        swapchainImageIndex = 0;
+        if (_frameNumber == 0)
+        {
+            _headlessStart = std::chrono::high_resolution_clock::now();
+        }
+    }
+    else
+    {
+        //resizes and out of date or suboptimal swapchains since the last frame are handled here, once
+        if (_swapchainDirty)
+        {
+            RecreateSwapchain();
+        }
+
+        //request image from the swapchain, one second timeout
+        VkResult result = _swapchain != VK_NULL_HANDLE
+            ? vkAcquireNextImageKHR(_device, _swapchain, 1000000000, frame._presentSemaphore, nullptr, &swapchainImageIndex)
+            : VK_SUCCESS;
+        if (result == VK_ERROR_OUT_OF_DATE_KHR)
+        {
+            //nothing can be presented to this swapchain anymore, the semaphore was left unsignaled so it can be reused right away
+            RecreateSwapchain();
+            result = _swapchain != VK_NULL_HANDLE
+                ? vkAcquireNextImageKHR(_device, _swapchain, 1000000000, frame._presentSemaphore, nullptr, &swapchainImageIndex)
+                : VK_SUCCESS;
+        }
+
+        if (result == VK_SUBOPTIMAL_KHR)
+        {
+            _swapchainDirty = true; // still presentable, recreated next frame
+        }
+        else
+        {
+            VK_CHECK(result);
+        }
+    }
+
+    _renderQueue.Clear();
+    _lastRenderStats = _renderStats;
+    _renderStats = RenderStats();
+
+    UpdateCameraData();
+
+    if (_gpuDriven)
+    {
+        _gpuCulling.BeginFrame((uint32_t)(_frameNumber % _frames.size()));
+    }
+
+    //without a swapchain nothing is recorded or presented, the frame only keeps the extraction and uploads going
+    _frameSkipped = !_headless && _swapchain == VK_NULL_HANDLE;
+    if (_frameSkipped)
+    {
+        return;
+    }
 
     //now that we are sure that the commands finished executing, we can safely reset the command buffer to begin recording again.
-    VK_CHECK(vkResetCommandBuffer(_mainCommandBuffer, 0));
+    VK_CHECK(vkResetCommandBuffer(frame._mainCommandBuffer, 0));
+    for (VkCommandPool recordingPool : frame._recordingCommandPools)
+    {
+        VK_CHECK(vkResetCommandPool(_device, recordingPool, 0));
+    }
 
     //begin the command buffer recording. We will use this command buffer exactly once, so we want to let Vulkan know that
     VkCommandBufferBeginInfo cmdBeginInfo = {};
@@ -1065,7 +1839,56 @@ void RenderingECSModule::PreDrawStep(float deltaTime)
     cmdBeginInfo.pInheritanceInfo = nullptr;
     cmdBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
-    VK_CHECK(vkBeginCommandBuffer(_mainCommandBuffer, &cmdBeginInfo));
+    VK_CHECK(vkBeginCommandBuffer(frame._mainCommandBuffer, &cmdBeginInfo));
+
+    //reads back the timestamps this frame's context wrote last time, they are complete since its fence was signaled
+    _gpuProfiler.BeginFrame(frame._mainCommandBuffer, (uint32_t)(_frameNumber % _frames.size()));
+    _frameScope = _gpuProfiler.BeginScope(frame._mainCommandBuffer, "Frame");
+}
+
+void RenderingECSModule::UpdateCameraData()
+{
+    const flecs::entity cameraEntity = GetMainCameraEntity(ecs());
+
+    //the view matrix is the expensive part, it used to be recomputed for every entity
+    CameraData camera;
+    camera.view = Transform::GetViewMatrix(cameraEntity);
+
+    if (const PerspectiveCamera* const perspectiveCamera = cameraEntity.get<PerspectiveCamera>())
+    {
+        camera.projection = perspectiveCamera->GetProjectionMatrix();
+        camera.farPlane = perspectiveCamera->GetFarPlaneOffset();
+        camera.perspective = 1;
+    }
+    else if (const OrthoCamera* const orthoCamera = cameraEntity.get<OrthoCamera>())
+    {
+        camera.projection = orthoCamera->GetProjectionMatrix();
+        camera.perspective = 0;
+    }
+    else
+    {
+        throw std::runtime_error("MainCamera singleton is missing a PerspectiveCamera or OrthoCamera component.");
+    }
+
+    camera.viewProjection = camera.projection * camera.view;
+    camera.frustum = Frustum::FromMatrix(camera.viewProjection);
+
+    //the depth the occlusion culling reads was rendered with last frame's camera
+    camera.previousViewProjection = _hasPreviousCamera ? _cameraData.viewProjection : camera.viewProjection;
+    _hasPreviousCamera = true;
+
+    _cameraData = camera;
+    ecs().set<CameraData>(camera);
+
+    //the frame's fence has been waited on, the GPU is done reading the previous content
+    FrameData& frame = GetCurrentFrame();
+    std::memcpy(frame._cameraBufferMapped, &camera, sizeof(CameraData));
+    vmaFlushAllocation(_allocator, frame._cameraBuffer._allocation, 0, VK_WHOLE_SIZE);
+}
+
+void RenderingECSModule::BeginMainRenderPass()
+{
+    FrameData& frame = GetCurrentFrame();
 
     VkClearValue clearValue = {};
     // float flash = abs(sin(_frameNumber / 3840.f));
@@ -1095,19 +1918,136 @@ void RenderingECSModule::PreDrawStep(float deltaTime)
     rpInfo.clearValueCount = 2;
     rpInfo.pClearValues = &clearValues[0];
 
-    vkCmdBeginRenderPass(_mainCommandBuffer, &rpInfo, VK_SUBPASS_CONTENTS_INLINE);
+    //timestamps cannot be written by the main command buffer inside the pass, the scope wraps it
+    _mainPassScope = _gpuProfiler.BeginScope(frame._mainCommandBuffer, "Main pass");
+
+    //every draw is recorded into secondary command buffers, executed in order by the main one
+    vkCmdBeginRenderPass(frame._mainCommandBuffer, &rpInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+    //the main thread's own draws and ImGui are executed last, after the render queue
+    BeginSecondaryCommandBuffer(frame._inlineCommandBuffer);
+}
+
+void RenderingECSModule::BeginSecondaryCommandBuffer(VkCommandBuffer cmd) const
+{
+    VkCommandBufferInheritanceInfo inheritanceInfo = {};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.pNext = nullptr;
+    inheritanceInfo.renderPass = _renderPass;
+    inheritanceInfo.subpass = 0;
+    inheritanceInfo.framebuffer = _framebuffers[swapchainImageIndex];
+
+    VkCommandBufferBeginInfo cmdBeginInfo = vkinit::command_buffer_begin_info(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT);
+    cmdBeginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    VK_CHECK(vkBeginCommandBuffer(cmd, &cmdBeginInfo));
+
+    //secondary command buffers inherit no state, every one binds the arena and sets the dynamic state itself
+    _meshArena.Bind(cmd);
+
+    //viewport and scissor are dynamic in every pipeline and survive pipeline binds
+    VkViewport viewport = {};
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = static_cast<float>(windowExtent.width);
+    viewport.height = static_cast<float>(windowExtent.height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+
+    VkRect2D scissor = {};
+    scissor.offset = {0, 0};
+    scissor.extent = {static_cast<uint32_t>(windowExtent.width), static_cast<uint32_t>(windowExtent.height)};
+
+    vkCmdSetViewport(cmd, 0, 1, &viewport);
+    vkCmdSetScissor(cmd, 0, 1, &scissor);
+}
+
+uint32_t RenderingECSModule::SelectLOD(const SimpleMesh& mesh, const glm::mat4& world) const
+{
+    if (mesh.GetLODCount() == 1 || _settings.lodThresholdPixels <= 0.0f || mesh._boundingSphere.radius <= 0.0f)
+    {
+        return 0;
+    }
+
+    //the nearest point of the bounds decides, so no part of the mesh shows more error than allowed
+    const BoundingSphere sphere = mesh._boundingSphere.Transform(world);
+    const float nearestDepth = _cameraData.GetViewDepth(glm::vec4(sphere.center, 1.0f)) - sphere.radius;
+    const float scale = sphere.radius / mesh._boundingSphere.radius;
+
+    const float pixelsPerUnit = _cameraData.GetPixelsPerUnit(nearestDepth, (float)windowExtent.height) * scale;
+    return mesh.SelectLOD(pixelsPerUnit, _settings.lodThresholdPixels);
+}
+
+void RenderingECSModule::RecordGPUCulling()
+{
+    if (!_gpuDriven || _gpuCulling.GetObjectCount() == 0)
+    {
+        return;
+    }
+
+    VkCommandBuffer cmd = GetCurrentFrame()._mainCommandBuffer;
+    GPUProfiler::Scope scope(_gpuProfiler, cmd, "GPU culling");
+
+    //compute dispatches are not allowed inside a render pass
+    const DepthPyramid* depthPyramid = nullptr;
+    bool hasDepth = false;
+    if (_gpuCulling.IsOcclusionEnabled())
+    {
+        //even without depth to reduce, Build moves the pyramid into the layout its descriptor was written with
+        GPUProfiler::Scope pyramidScope(_gpuProfiler, cmd, "Hi-Z build");
+        hasDepth = _depthPyramid.Build(cmd, _depthImage._image, _depthHistoryValid);
+        depthPyramid = &_depthPyramid;
+    }
+
+    _gpuCulling.RecordCulling(cmd, _cameraData.frustum, GetCurrentFrame()._cameraDescriptorSet, depthPyramid, hasDepth);
+}
+
+void RenderingECSModule::SubmitGPUDrivenDraws()
+{
+    if (!_gpuDriven)
+    {
+        return;
+    }
+
+    FrameData& frame = GetCurrentFrame();
+    GPUProfiler::Scope scope(_gpuProfiler, frame._inlineCommandBuffer, "GPU-driven draws");
+    _gpuCulling.RecordDraws(frame._inlineCommandBuffer, frame._cameraDescriptorSet, _meshArena, _renderStats);
 }
 
 void RenderingECSModule::PostDrawStep(float deltaTime)
 {
+    FrameData& frame = GetCurrentFrame();
+
+    //kick off every upload queued while drawing this frame
+    _meshUploader.Submit();
+
+    if (_frameSkipped)
+    {
+        //ends the ImGui frame, and signals the fence the next use of this frame waits on
+        ImGui::Render();
+        VK_CHECK(vkQueueSubmit(_graphicsQueue, 0, nullptr, frame._renderFence));
+        DeferMeshReleases(frame);
+        _frameSkipped = false;
+        return;
+    }
+
     // Rendering imgui
     ImGui::Render();
-    ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), _mainCommandBuffer);
+    {
+        GPUProfiler::Scope scope(_gpuProfiler, frame._inlineCommandBuffer, "ImGui");
+        ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), frame._inlineCommandBuffer);
+    }
+
+    VK_CHECK(vkEndCommandBuffer(frame._inlineCommandBuffer));
+    vkCmdExecuteCommands(frame._mainCommandBuffer, 1, &frame._inlineCommandBuffer);
 
     //finalize the render pass
-    vkCmdEndRenderPass(_mainCommandBuffer);
+    vkCmdEndRenderPass(frame._mainCommandBuffer);
+    _depthHistoryValid = true;
+    _gpuProfiler.EndScope(frame._mainCommandBuffer, _mainPassScope);
+    _gpuProfiler.EndScope(frame._mainCommandBuffer, _frameScope);
     //finalize the command buffer (we can no longer add commands, but it can now be executed)
-    VK_CHECK(vkEndCommandBuffer(_mainCommandBuffer));
+    VK_CHECK(vkEndCommandBuffer(frame._mainCommandBuffer));
 
 
     //prepare the submission to the queue.
@@ -1122,18 +2062,28 @@ void RenderingECSModule::PostDrawStep(float deltaTime)
 
     submit.pWaitDstStageMask = &waitStage;
 
-    submit.waitSemaphoreCount = 1;
-    submit.pWaitSemaphores = &_presentSemaphore;
+    //headless frames have no image to wait for and nothing to present
+    submit.waitSemaphoreCount = _headless ? 0 : 1;
+    submit.pWaitSemaphores = &frame._presentSemaphore;
 
-    submit.signalSemaphoreCount = 1;
-    submit.pSignalSemaphores = &_renderSemaphore;
+    submit.signalSemaphoreCount = _headless ? 0 : 1;
+    submit.pSignalSemaphores = &frame._renderSemaphore;
 
     submit.commandBufferCount = 1;
-    submit.pCommandBuffers = &_mainCommandBuffer;
+    submit.pCommandBuffers = &frame._mainCommandBuffer;
 
     //submit command buffer to the queue and execute it.
     // _renderFence will now block until the graphic commands finish execution
-    VK_CHECK(vkQueueSubmit(_graphicsQueue, 1, &submit, _renderFence));
+    VK_CHECK(vkQueueSubmit(_graphicsQueue, 1, &submit, frame._renderFence));
+
+    DeferMeshReleases(frame);
+
+    if (_headless)
+    {
+        //run at maximum rate, the next frame only waits for its own fence
+        _frameNumber++;
+        return;
+    }
 
 
     // this will put the image we just rendered into the visible window.
@@ -1146,7 +2096,7 @@ void RenderingECSModule::PostDrawStep(float deltaTime)
     presentInfo.pSwapchains = &_swapchain;
     presentInfo.swapchainCount = 1;
 
-    presentInfo.pWaitSemaphores = &_renderSemaphore;
+    presentInfo.pWaitSemaphores = &frame._renderSemaphore;
     presentInfo.waitSemaphoreCount = 1;
 
     presentInfo.pImageIndices = &swapchainImageIndex;
@@ -1154,6 +2104,8 @@ void RenderingECSModule::PostDrawStep(float deltaTime)
     VkResult result = vkQueuePresentKHR(_graphicsQueue, &presentInfo);
     if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
     {
+        //the window changed under the swapchain, recreate it before the next acquire
+        _swapchainDirty = true;
     }
     else
     {
@@ -1164,218 +2116,289 @@ void RenderingECSModule::PostDrawStep(float deltaTime)
     _frameNumber++;
 }
 
-void RenderingECSModule::BindPipeline(const Material& material)
+void RenderingECSModule::BindPipeline(RecordingContext& context, const VkPipeline pipeline) const
 {
-    vkCmdBindPipeline(_mainCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, *material.pipeline);
+    vkCmdBindPipeline(context.cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+    context.currentPipeline = pipeline;
 
-    VkViewport viewport = {};
-    viewport.x = 0.0f;
-    viewport.y = 0.0f;
-    viewport.width = static_cast<float>(windowExtent.width);
-    viewport.height = static_cast<float>(windowExtent.height);
-    viewport.minDepth = 0.0f;
-    viewport.maxDepth = 1.0f;
-
-    VkRect2D scissor = {};
-    scissor.offset = {0, 0};
-    scissor.extent = {static_cast<uint32_t>(windowExtent.width), static_cast<uint32_t>(windowExtent.height)};
-
-    vkCmdSetViewport(_mainCommandBuffer, 0, 1, &viewport);
-    vkCmdSetScissor(_mainCommandBuffer, 0, 1, &scissor);
+    ++context.stats.pipelineBinds;
 }
 
-void RenderingECSModule::Draw
-(
-    const float deltaTime,
-    const glm::mat4 renderMatrix,
-    const SimpleMesh& mesh,
-    const Material& material
-)
+void RenderingECSModule::Draw(RecordingContext& context, const DrawCommand& command) const
 {
-    //bind the mesh vertex buffer with offset 0
-    VkDeviceSize offset = 0;
-    vkCmdBindVertexBuffers(_mainCommandBuffer, 0, 1, &mesh._vertexBuffer._buffer, &offset);
-
-    vkCmdBindIndexBuffer(_mainCommandBuffer, mesh._indexBuffer._buffer, 0, VK_INDEX_TYPE_UINT32);
-
     MeshPushConstants constants = {};
     
-    constants.color = material.color;
-    constants.renderMatrix = renderMatrix;
+    constants.color = command.color;
+    constants.modelMatrix = command.modelMatrix;
 
     //upload the matrix to the GPU via push constants
-    vkCmdPushConstants(_mainCommandBuffer, *material.pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(MeshPushConstants), &constants);
+    vkCmdPushConstants(context.cmd, command.pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(MeshPushConstants), &constants);
 
-    //we can now draw the mesh
-    vkCmdDrawIndexed(_mainCommandBuffer, (uint32_t)mesh._indices.size(), 1, 0, 0, 0);
+    //we can now draw the mesh, the arena's buffers were bound when the command buffer began
+    const MeshRange range = command.mesh->GetLODRange(command.lod);
+    vkCmdDrawIndexed(context.cmd, range.indexCount, 1, range.firstIndex, range.vertexOffset, 0);
+
+    ++context.stats.drawCalls;
+    context.stats.triangles += range.indexCount / 3;
 }
 
-template<typename TMesh>
-void RenderingECSModule::UploadMesh(TMesh& mesh)
+void RenderingECSModule::SubmitRenderQueue()
 {
-    if (typeid(TMesh) != typeid(SimpleMesh))
+    FrameData& frame = GetCurrentFrame();
+
+    _renderStats.drawCommands = (uint32_t)_renderQueue.Size();
+    _renderStats.pipelineBindsUnsorted = _renderQueue.CountUnsortedPipelineChanges();
+
+    if (_renderQueue.Size() == 0)
     {
-        throw std::exception("Anything other than SimpleMesh is the only thing implemented at the moment.");
+        return;
     }
 
-    const size_t verticesBufferSize = mesh._vertices.size() * sizeof(SimpleMesh);
-    //allocate vertex buffer
-    VkBufferCreateInfo stagingVerticesBufferInfo = {};
-    stagingVerticesBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    //this is the total size, in bytes, of the buffer we are allocating
-    stagingVerticesBufferInfo.size = verticesBufferSize;
-    //this buffer is going to be used as a Vertex Buffer
-    stagingVerticesBufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    const auto recordingStart = std::chrono::high_resolution_clock::now();
 
+    _renderQueue.Sort();
 
-    //let the VMA library know that this data should be writeable by CPU, but also readable by GPU
-    VmaAllocationCreateInfo vmaallocInfo = {};
-    vmaallocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+    //every instanced command gets a slot in the instance buffer, in sorted order
+    uint32_t instanceCount = 0;
+    for (size_t i = 0; i < _renderQueue.Size(); ++i)
+    {
+        instanceCount += _renderQueue.GetSorted(i).instanced ? 1 : 0;
+    }
 
-    AllocatedBuffer stagingVerticesBuffer;
+    InstanceData* mappedInstances = nullptr;
+    if (instanceCount > 0)
+    {
+        ReserveInstanceBuffer(frame, instanceCount);
+        mappedInstances = static_cast<InstanceData*>(frame._instanceBufferMapped);
+    }
 
-    // Allocate vertex buffer
-    VK_CHECK(vmaCreateBuffer(_allocator, &stagingVerticesBufferInfo, &vmaallocInfo,
-        &stagingVerticesBuffer._buffer,
-        &stagingVerticesBuffer._allocation,
-        nullptr));
-    
-    // Allocate index buffer
-    const size_t indicesBufferSize = mesh._indices.size() * sizeof(uint32_t); // Size of index buffer in bytes
-    VkBufferCreateInfo stagingIndicesBufferInfo = {};
-    stagingIndicesBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    stagingIndicesBufferInfo.size =  indicesBufferSize;
-    stagingIndicesBufferInfo.usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-    VmaAllocationCreateInfo indexAllocInfo = {};
-    indexAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
-
-    AllocatedBuffer stagingIndicesBuffer;
-
-    // Allocate the index buffer
-    VK_CHECK(vmaCreateBuffer(_allocator, &stagingIndicesBufferInfo, &indexAllocInfo,
-        &stagingIndicesBuffer._buffer,
-        &stagingIndicesBuffer._allocation,
-        nullptr));
-
-    //copy vertex data
-    void* vertexData;
-    vmaMapMemory(_allocator, stagingVerticesBuffer._allocation, &vertexData);
-    memcpy(vertexData, mesh._vertices.data(), mesh._vertices.size() * sizeof(SimpleVertex));
-    vmaUnmapMemory(_allocator, stagingVerticesBuffer._allocation);
-
-    // Copy index data
-    void* indexData;
-    vmaMapMemory(_allocator, stagingIndicesBuffer._allocation, &indexData);
-    memcpy(indexData, mesh._indices.data(), mesh._indices.size() * sizeof(uint32_t));
-    vmaUnmapMemory(_allocator, stagingIndicesBuffer._allocation);
-
-
-    // ------------------------------------------------------
-    // --- GPU Buffers --------------------------------------
-    // ------------------------------------------------------
-
-    VkBufferCreateInfo verticesBufferInfo = {};
-    verticesBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    verticesBufferInfo.pNext = nullptr;
-    //this is the total size, in bytes, of the buffer we are allocating
-    verticesBufferInfo.size = verticesBufferSize;
-    //this buffer is going to be used as a Vertex Buffer
-    verticesBufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-
-    //let the VMA library know that this data should be GPU native
-    vmaallocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
-
-    //allocate the buffer
-    VK_CHECK(vmaCreateBuffer(_allocator, &verticesBufferInfo, &vmaallocInfo,
-        &mesh._vertexBuffer._buffer,
-        &mesh._vertexBuffer._allocation,
-        nullptr));
-    
-    VkBufferCreateInfo indicesBufferInfo = {};
-    indicesBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    indicesBufferInfo.pNext = nullptr;
-    //this is the total size, in bytes, of the buffer we are allocating
-    indicesBufferInfo.size = indicesBufferSize;
-    //this buffer is going to be used as a Vertex Buffer
-    indicesBufferInfo.usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-
-    //let the VMA library know that this data should be GPU native
-    vmaallocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
-
-    //allocate the buffer
-    VK_CHECK(vmaCreateBuffer(_allocator, &indicesBufferInfo, &vmaallocInfo,
-        &mesh._indexBuffer._buffer,
-        &mesh._indexBuffer._allocation,
-        nullptr));
-    
-    ImmediateSubmit
-    (
-        [=](VkCommandBuffer cmd)
+    //turn the sorted queue into draw calls, so the slices recorded in parallel never split a batch
+    _queuedDraws.clear();
+    uint32_t firstInstance = 0;
+    size_t i = 0;
+    while (i < _renderQueue.Size())
+    {
+        const DrawCommand& command = _renderQueue.GetSorted(i);
+
+        if (!command.instanced)
         {
-            VkBufferCopy copy;
-            copy.dstOffset = 0;
-            copy.srcOffset = 0;
-            copy.size = verticesBufferSize;
-            vkCmdCopyBuffer(cmd, stagingVerticesBuffer._buffer, mesh._vertexBuffer._buffer, 1, &copy);
+            _queuedDraws.push_back({(uint32_t)i, 0, 0});
+            ++i;
+            continue;
         }
-    );
 
-    ImmediateSubmit
-    (
-        [=](VkCommandBuffer cmd)
+        //sorting put every command sharing this pipeline and mesh right after this one, draw them all at once
+        const uint32_t batchStart = (uint32_t)i;
+        const uint64_t batchKey = _renderQueue.GetSortedKey(i);
+        uint32_t batchSize = 0;
+        while (i < _renderQueue.Size() && RenderQueue::IsSameBatch(_renderQueue.GetSortedKey(i), batchKey))
         {
-            VkBufferCopy copy;
-            copy.dstOffset = 0;
-            copy.srcOffset = 0;
-            copy.size = indicesBufferSize;
-            vkCmdCopyBuffer(cmd, stagingIndicesBuffer._buffer, mesh._indexBuffer._buffer, 1, &copy);
+            const DrawCommand& instanceCommand = _renderQueue.GetSorted(i);
+
+            InstanceData& instance = mappedInstances[firstInstance + batchSize];
+            instance.modelMatrix = instanceCommand.modelMatrix;
+            instance.color = instanceCommand.color;
+
+            ++batchSize;
+            ++i;
         }
-    );
 
-    // ------------------------------------------------------
-    // --- CPU & GPU Buffers Cleanup ------------------------
-    // ------------------------------------------------------
+        _queuedDraws.push_back({batchStart, batchSize, firstInstance});
+        firstInstance += batchSize;
+    }
 
-    _mainDeletionQueue.PushDeletor
+    if (instanceCount > 0)
+    {
+        //the buffer is host coherent only if the allocator picked such a memory type
+        vmaFlushAllocation(_allocator, frame._instanceBuffer._allocation, 0, VK_WHOLE_SIZE);
+    }
+
+    //one slice per recording thread, unless there are too few draws for the split to pay off
+    const uint32_t drawCount = (uint32_t)_queuedDraws.size();
+    const uint32_t jobCount = std::clamp
     (
-        [=]()
+        (drawCount + MIN_DRAWS_PER_RECORDING_JOB - 1) / MIN_DRAWS_PER_RECORDING_JOB,
+        1u,
+        (uint32_t)frame._recordingCommandBuffers.size()
+    );
+
+    _recordingContexts.assign(jobCount, RecordingContext());
+    _jobSystem->ParallelFor(jobCount, [this, jobCount](uint32_t job)
+    {
+        RecordRenderQueueSlice(job, jobCount);
+    });
+
+    //slices are contiguous in sorted order, executing them in order keeps the sorted draw order
+    std::vector<VkCommandBuffer> secondaryCommandBuffers(jobCount);
+    for (uint32_t job = 0; job < jobCount; ++job)
+    {
+        const RecordingContext& context = _recordingContexts[job];
+        secondaryCommandBuffers[job] = context.cmd;
+        _renderStats.drawCalls += context.stats.drawCalls;
+        _renderStats.triangles += context.stats.triangles;
+        _renderStats.pipelineBinds += context.stats.pipelineBinds;
+    }
+    vkCmdExecuteCommands(frame._mainCommandBuffer, jobCount, secondaryCommandBuffers.data());
+
+    _renderStats.recordingJobs = jobCount;
+    _renderStats.recordingTimeMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - recordingStart).count();
+}
+
+void RenderingECSModule::RecordRenderQueueSlice(const uint32_t job, const uint32_t jobCount)
+{
+    FrameData& frame = GetCurrentFrame();
+
+    RecordingContext& context = _recordingContexts[job];
+    context.cmd = frame._recordingCommandBuffers[job];
+
+    BeginSecondaryCommandBuffer(context.cmd);
+
+    if (frame._instanceBuffer.IsInitialized())
+    {
+        //binding 0 holds the arena's vertex buffer, only the instance binding is added
+        VkDeviceSize instanceOffset = 0;
+        vkCmdBindVertexBuffers(context.cmd, InstanceData::BINDING, 1, &frame._instanceBuffer._buffer, &instanceOffset);
+    }
+
+    const size_t drawCount = _queuedDraws.size();
+    const size_t begin = drawCount * job / jobCount;
+    const size_t end = drawCount * (job + 1) / jobCount;
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        const QueuedDraw& draw = _queuedDraws[i];
+        const DrawCommand& command = _renderQueue.GetSorted(draw.command);
+
+        if (context.currentPipeline != command.pipeline)
         {
-            vmaDestroyBuffer(_allocator, mesh._vertexBuffer._buffer, mesh._vertexBuffer._allocation);
-            vmaDestroyBuffer(_allocator, mesh._indexBuffer._buffer, mesh._indexBuffer._allocation);
+            //every run of draws sharing a pipeline is timed as a batch of its material
+            _gpuProfiler.EndScope(context.cmd, context.batchScope);
+            context.batchScope = _gpuProfiler.BeginScope(context.cmd, GetPipelineName(command.pipeline));
+
+            BindPipeline(context, command.pipeline);
         }
-    );
 
-    vmaDestroyBuffer(_allocator, stagingVerticesBuffer._buffer, stagingVerticesBuffer._allocation);
-    vmaDestroyBuffer(_allocator, stagingIndicesBuffer._buffer, stagingIndicesBuffer._allocation);
+        if (context.currentLayout != command.pipelineLayout)
+        {
+            //set 0 only survives layout changes when the push constant ranges match, rebind it whenever the layout changes
+            vkCmdBindDescriptorSets(context.cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, command.pipelineLayout, 0, 1, &frame._cameraDescriptorSet, 0, nullptr);
+            context.currentLayout = command.pipelineLayout;
+        }
+
+        const MeshRange range = command.mesh->GetLODRange(command.lod);
+        if (context.currentIndexType != range.indexType)
+        {
+            _meshArena.BindIndexBuffer(context.cmd, range.indexType);
+            context.currentIndexType = range.indexType;
+        }
+
+        if (draw.instanceCount == 0)
+        {
+            Draw(context, command);
+            continue;
+        }
+
+        //firstInstance points at the batch's slice of the instance buffer
+        vkCmdDrawIndexed(context.cmd, range.indexCount, draw.instanceCount, range.firstIndex, range.vertexOffset, draw.firstInstance);
+        ++context.stats.drawCalls;
+        context.stats.triangles += range.indexCount / 3 * draw.instanceCount;
+    }
+
+    _gpuProfiler.EndScope(context.cmd, context.batchScope);
+
+    VK_CHECK(vkEndCommandBuffer(context.cmd));
 }
 
-void RenderingECSModule::ImmediateSubmit(std::function<void(VkCommandBuffer cmd)>&& function)
+void RenderingECSModule::ReserveInstanceBuffer(FrameData& frame, const uint32_t instanceCount)
 {
-    VkCommandBuffer cmd = _uploadContext._commandBuffer;
+    if (instanceCount <= frame._instanceCapacity)
+    {
+        return;
+    }
 
-    //begin the command buffer recording. We will use this command buffer exactly once before resetting, so we tell vulkan that
-    VkCommandBufferBeginInfo cmdBeginInfo = vkinit::command_buffer_begin_info(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    //the frame's fence has already been waited on, so the old buffer is no longer in use by the GPU
+    if (frame._instanceBuffer.IsInitialized())
+    {
+        vmaDestroyBuffer(_allocator, frame._instanceBuffer._buffer, frame._instanceBuffer._allocation);
+        frame._instanceBuffer = AllocatedBuffer();
+        frame._instanceBufferMapped = nullptr;
+    }
 
-    VK_CHECK(vkBeginCommandBuffer(cmd, &cmdBeginInfo));
+    //grow geometrically so a slowly growing scene doesn't reallocate every frame
+    uint32_t newCapacity = std::max(frame._instanceCapacity * 2, 1024u);
+    while (newCapacity < instanceCount)
+    {
+        newCapacity *= 2;
+    }
 
-    //execute the function
-    function(cmd);
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.pNext = nullptr;
+    bufferInfo.size = newCapacity * sizeof(InstanceData);
+    bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
 
-    VK_CHECK(vkEndCommandBuffer(cmd));
+    //written by the CPU every frame and read once by the GPU, keep it persistently mapped
+    VmaAllocationCreateInfo vmaallocInfo = {};
+    vmaallocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+    vmaallocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
 
-    VkSubmitInfo submit = vkinit::submit_info(&cmd);
+    VmaAllocationInfo allocationInfo = {};
+    VK_CHECK(vmaCreateBuffer(_allocator, &bufferInfo, &vmaallocInfo,
+        &frame._instanceBuffer._buffer,
+        &frame._instanceBuffer._allocation,
+        &allocationInfo));
 
+    frame._instanceBufferMapped = allocationInfo.pMappedData;
+    frame._instanceCapacity = newCapacity;
+}
 
-    //submit command buffer to the queue and execute it.
-    // _uploadFence will now block until the graphic commands finish execution
-    VK_CHECK(vkQueueSubmit(_graphicsQueue, 1, &submit, _uploadContext._uploadFence));
+void RenderingECSModule::DeferMeshReleases(FrameData& frame)
+{
+    if (_releasedMeshes->empty())
+    {
+        return;
+    }
+
+    //a mesh may be released before or after this frame's fence was waited on, only this submission is known to cover every draw of it
+    //the frame's deletion queue is flushed once its fence is waited on again, after the submission that last drew these ranges
+    frame._deletionQueue.PushDeletor
+    (
+        [=, releasedMeshes = std::move(*_releasedMeshes)]()
+        {
+            for (const std::pair<MeshRange, uint64_t>& released : releasedMeshes)
+            {
+                //the transfer queue may still be copying into a range, it waits for another frame
+                if (_meshUploader.IsComplete(released.second))
+                {
+                    _meshArena.Free(released.first);
+                }
+                else
+                {
+                    _releasedMeshes->push_back(released);
+                }
+            }
+        }
+    );
+    _releasedMeshes->clear();
+}
 
-    vkWaitForFences(_device, 1, &_uploadContext._uploadFence, true, 9999999999);
-    vkResetFences(_device, 1, &_uploadContext._uploadFence);
+template<typename TMesh>
+bool RenderingECSModule::UploadMesh(TMesh& mesh)
+{
+    if (typeid(TMesh) != typeid(SimpleMesh))
+    {
+        throw std::exception("Anything other than SimpleMesh is the only thing implemented at the moment.");
+    }
 
-    // reset the command buffers inside the command pool
-    vkResetCommandPool(_device, _uploadContext._commandPool, 0);
+    //never blocks, the copy is recorded into the uploader's current batch and submitted at the end of the frame
+    if (!_meshUploader.TryEnqueue(mesh))
+    {
+        return false;
+    }
+
+    //removing or overwriting the mesh hands its range back here, for as long as the module lives
+    mesh._releasedRanges = _releasedMeshes;
+    return true;
 }
 
 void RenderingECSModule::DisplayFPSCounter() const
@@ -1407,4 +2430,157 @@ void RenderingECSModule::DisplayFPSCounter() const
     ImGui::End();
 }
 
+void RenderingECSModule::DisplayRenderStats() const
+{
+    static ImGuiIO& io = ImGui::GetIO(); (void)io;
+
+    ImGuiWindowFlags windowFlags =
+        ImGuiWindowFlags_NoDecoration |
+        ImGuiWindowFlags_AlwaysAutoResize |
+        ImGuiWindowFlags_NoSavedSettings |
+        ImGuiWindowFlags_NoFocusOnAppearing |
+        ImGuiWindowFlags_NoNav
+        ;
+
+    // Stack it under the FPS counter
+    ImVec2 windowPos = ImVec2(io.DisplaySize.x - 10.0f, 70.0f);
+    ImVec2 windowPivot = ImVec2(1.0f, 0.0f);
+    ImGui::SetNextWindowPos(windowPos, ImGuiCond_Always, windowPivot);
+
+    ImGui::Begin("Render Stats", nullptr, windowFlags);
+
+    // Counters of the previous frame, this runs before the render queue is submitted
+    ImGui::Text("Draw commands: %u", _lastRenderStats.drawCommands);
+    ImGui::Text("Culled: %u", _lastRenderStats.culled);
+    ImGui::Text("GPU-driven: %u", _lastRenderStats.gpuDrivenObjects);
+    ImGui::Text("Draw calls: %u", _lastRenderStats.drawCalls);
+    ImGui::Text("Triangles: %u", _lastRenderStats.triangles);
+    ImGui::Text("Simplified: %u", _lastRenderStats.simplified);
+    ImGui::Text("Pipeline binds: %u", _lastRenderStats.pipelineBinds);
+    ImGui::Text("Binds saved: %u", _lastRenderStats.GetPipelineBindsSaved());
+    ImGui::Text("Recording: %.2f ms (%u jobs)", _lastRenderStats.recordingTimeMs, _lastRenderStats.recordingJobs);
+
+    ImGui::End();
+}
+
+void RenderingECSModule::DisplayGPUProfiler() const
+{
+    if (!_gpuProfiler.IsSupported())
+    {
+        return;
+    }
+
+    ImGuiWindowFlags windowFlags =
+        ImGuiWindowFlags_NoDecoration |
+        ImGuiWindowFlags_AlwaysAutoResize |
+        ImGuiWindowFlags_NoSavedSettings |
+        ImGuiWindowFlags_NoFocusOnAppearing |
+        ImGuiWindowFlags_NoNav
+        ;
+
+    // Opposite corner from the FPS counter
+    ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f), ImGuiCond_Always, ImVec2(0.0f, 0.0f));
+
+    ImGui::Begin("GPU Profiler", nullptr, windowFlags);
+
+    // Timings are read back frames in flight later, averaged over the profiler's history
+    ImGui::Text("GPU time (avg of %u frames)", GPUProfiler::HISTORY_SIZE);
+
+    if (ImGui::BeginTable("GPU Passes", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV))
+    {
+        ImGui::TableSetupColumn("Pass");
+        ImGui::TableSetupColumn("Avg ms");
+        ImGui::TableSetupColumn("Last ms");
+        ImGui::TableSetupColumn("Max ms");
+        ImGui::TableSetupColumn("History");
+        ImGui::TableHeadersRow();
+
+        for (const GPUProfiler::PassTiming& pass : _gpuProfiler.GetPassTimings())
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(pass.name.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", pass.averageMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", pass.lastMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", pass.maxMs);
+            ImGui::TableNextColumn();
+
+            // the ring is full once historyCount reaches its size, the oldest entry is then at historyOffset
+            const int offset = pass.historyCount == GPUProfiler::HISTORY_SIZE ? (int)pass.historyOffset : 0;
+            ImGui::PushID(pass.name.c_str());
+            ImGui::PlotLines("", pass.history.data(), (int)pass.historyCount, offset, nullptr, 0.0f, pass.maxMs, ImVec2(120.0f, 18.0f));
+            ImGui::PopID();
+        }
+
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+void RenderingECSModule::DisplayPresentSettings()
+{
+    if (_headless)
+    {
+        return; // nothing is presented
+    }
+
+    static ImGuiIO& io = ImGui::GetIO(); (void)io;
+
+    ImGuiWindowFlags windowFlags =
+        ImGuiWindowFlags_NoDecoration |
+        ImGuiWindowFlags_AlwaysAutoResize |
+        ImGuiWindowFlags_NoSavedSettings |
+        ImGuiWindowFlags_NoFocusOnAppearing |
+        ImGuiWindowFlags_NoNav
+        ;
+
+    // Bottom-right corner, under the render stats
+    ImVec2 windowPos = ImVec2(io.DisplaySize.x - 10.0f, io.DisplaySize.y - 10.0f);
+    ImVec2 windowPivot = ImVec2(1.0f, 1.0f);
+    ImGui::SetNextWindowPos(windowPos, ImGuiCond_Always, windowPivot);
+
+    ImGui::Begin("Present Settings", nullptr, windowFlags);
+
+    static const VkPresentModeKHR presentModes[] =
+    {
+        VK_PRESENT_MODE_FIFO_KHR,
+        VK_PRESENT_MODE_FIFO_RELAXED_KHR,
+        VK_PRESENT_MODE_MAILBOX_KHR,
+        VK_PRESENT_MODE_IMMEDIATE_KHR,
+    };
+
+    // The requested mode is selected, the one in use is shown next to it when the surface lacks it
+    ImGui::SetNextItemWidth(140.0f);
+    if (ImGui::BeginCombo("Present mode", GetPresentModeName(_settings.presentMode)))
+    {
+        for (const VkPresentModeKHR presentMode : presentModes)
+        {
+            if (ImGui::Selectable(GetPresentModeName(presentMode), presentMode == _settings.presentMode))
+            {
+                SetPresentMode(presentMode);
+            }
+        }
+        ImGui::EndCombo();
+    }
+    if (_presentMode != _settings.presentMode)
+    {
+        ImGui::Text("Using %s", GetPresentModeName(_presentMode));
+    }
+
+    bool lowLatency = _settings.lowLatency;
+    if (ImGui::Checkbox("Low latency", &lowLatency))
+    {
+        SetLowLatency(lowLatency);
+    }
+
+    ImGui::Text("Input to present: %.2f ms", _framePacer.GetInputToPresentMs());
+    ImGui::Text("Present interval: %.2f ms", _framePacer.GetPresentIntervalMs());
+
+    ImGui::End();
+}
+
 } // namespace velecs
@@ -58,8 +58,6 @@ flecs::entity Prefab::Create
     flecs::world& world = ecs();
     flecs::entity prefab = world.prefab(name.c_str());
 
-    transform.entity = flecs::entity::null();
-
     prefab.set_override<Transform>(transform);
 
     return prefab;
@@ -76,7 +74,7 @@ flecs::entity Prefab::Create
     Transform transform;
 
     transform.position = pos.value_or(Vec3::ZERO);
-    transform.rotation = rot.value_or(Vec3::ZERO);
+    transform.SetEulerAngles(rot.value_or(Vec3::ZERO));
     transform.scale = scale.value_or(Vec3::ONE);
 
     return Create(name, transform);
@@ -108,7 +106,14 @@ flecs::entity Prefab::CreateFromPrefab
     Transform transform;
 
     transform.position = pos.value_or(prefabTransform->position);
-    transform.rotation = rot.value_or(prefabTransform->rotation);
+    if (rot)
+    {
+        transform.SetEulerAngles(rot.value());
+    }
+    else
+    {
+        transform.SetRotation(prefabTransform->GetRotation());
+    }
     transform.scale = scale.value_or(prefabTransform->scale);
 
     return CreateFromPrefab(name, prefab, transform);
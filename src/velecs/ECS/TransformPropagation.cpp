@@ -0,0 +1,152 @@
+/// @file    TransformPropagation.cpp
+/// @author  Matthew Green
+/// @date    2026-10-18 07:15:46
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/ECS/TransformPropagation.h"
+
+#include "velecs/Core/JobSystem.h"
+
+#include <algorithm>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+TransformPropagation::TransformPropagation(flecs::world& ecs, JobSystem* const jobSystem)
+    : jobSystem(jobSystem)
+{
+    //cascade visits the tables of parents before those of their children, every parent cache is final when read
+    query = ecs.query_builder<const Transform, const WorldTransform*, WorldTransform>()
+        .term_at(1).self()
+        .term_at(2).parent().cascade()
+        .term_at(3).self()
+        .build();
+}
+
+// Public Methods
+
+void TransformPropagation::Run()
+{
+    if (jobSystem == nullptr || jobSystem->GetThreadCount() == 1)
+    {
+        query.iter([](flecs::iter& it, const Transform* transforms, const WorldTransform* parentWorlds, WorldTransform* worlds)
+            {
+                //ChildOf is part of the table, the whole table shares one parent
+                const flecs::entity_t parent = parentWorlds != nullptr ? it.src(2).id() : 0;
+                Transform::RefreshWorldTransforms(it.count(), transforms, worlds, parent, parentWorlds);
+            }
+        );
+        return;
+    }
+
+    Gather();
+
+    for (const std::vector<Job>& jobs : levels)
+    {
+        RunLevel(jobs);
+    }
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void TransformPropagation::Gather()
+{
+    for (std::vector<Job>& jobs : levels)
+    {
+        jobs.clear();
+    }
+    tableLevels.clear();
+
+    query.iter([this](flecs::iter& it, const Transform* transforms, const WorldTransform* parentWorlds, WorldTransform* worlds)
+        {
+            //ChildOf is part of the table, the whole table shares one parent and sits one level below the table of the parent
+            const flecs::entity_t parent = parentWorlds != nullptr ? it.src(2).id() : 0;
+
+            uint32_t level = 0;
+            if (parent != 0)
+            {
+                const auto parentLevel = tableLevels.find(ecs_get_table(it.world().c_ptr(), parent));
+                if (parentLevel != tableLevels.end())
+                {
+                    level = parentLevel->second + 1;
+                }
+            }
+            tableLevels[it.c_ptr()->table] = level;
+
+            if (levels.size() <= level)
+            {
+                levels.resize(level + 1);
+            }
+
+            const int32_t count = it.count();
+            for (int32_t first = 0; first < count; first += CHUNK_SIZE)
+            {
+                Job job;
+                job.transforms = transforms + first;
+                job.worlds = worlds + first;
+                job.parentWorld = parentWorlds;
+                job.parent = parent;
+                job.count = (uint32_t)std::min(CHUNK_SIZE, count - first);
+                levels[level].push_back(job);
+            }
+        }
+    );
+}
+
+void TransformPropagation::RunLevel(const std::vector<Job>& jobs)
+{
+    uint32_t levelSize = 0;
+    for (const Job& job : jobs)
+    {
+        levelSize += job.count;
+    }
+
+    //small tables are grouped, a thread taking a single entity would spend more time waking up than refreshing it,
+    //still aiming for a few groups per thread so a slow one does not hold up the level
+    const uint32_t targetSize = std::max(std::min(levelSize / (jobSystem->GetThreadCount() * 4), (uint32_t)CHUNK_SIZE), MIN_GROUP_SIZE);
+
+    groups.clear();
+    uint32_t groupStart = 0;
+    uint32_t groupSize = 0;
+    for (uint32_t i = 0; i < (uint32_t)jobs.size(); ++i)
+    {
+        groupSize += jobs[i].count;
+        if (groupSize >= targetSize)
+        {
+            groups.emplace_back(groupStart, i + 1);
+            groupStart = i + 1;
+            groupSize = 0;
+        }
+    }
+    if (groupStart < (uint32_t)jobs.size())
+    {
+        groups.emplace_back(groupStart, (uint32_t)jobs.size());
+    }
+
+    //every job writes its own slice of a table, the caches it reads were written by the level above
+    jobSystem->ParallelFor((uint32_t)groups.size(), [this, &jobs](uint32_t index)
+        {
+            for (uint32_t i = groups[index].first; i < groups[index].second; ++i)
+            {
+                const Job& job = jobs[i];
+                Transform::RefreshWorldTransforms(job.count, job.transforms, job.worlds, job.parent, job.parentWorld);
+            }
+        }
+    );
+}
+
+} // namespace velecs
@@ -0,0 +1,81 @@
+/// @file    Bounds.cpp
+/// @author  Matthew Green
+/// @date    2026-10-17 22:45:03
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Math/Bounds.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+AABB::AABB(const glm::vec3 min, const glm::vec3 max)
+    : min(min), max(max) {}
+
+BoundingSphere::BoundingSphere(const glm::vec3 center, const float radius)
+    : center(center), radius(radius) {}
+
+// Public Methods
+
+glm::vec3 AABB::GetCenter() const
+{
+    return (min + max) * 0.5f;
+}
+
+glm::vec3 AABB::GetExtents() const
+{
+    return (max - min) * 0.5f;
+}
+
+AABB AABB::Transform(const glm::mat4& matrix) const
+{
+    // Arvo's method: project the extents onto every axis of the new frame
+    const glm::vec3 center = glm::vec3(matrix * glm::vec4(GetCenter(), 1.0f));
+    const glm::vec3 extents = GetExtents();
+
+    glm::vec3 newExtents{0.0f};
+    for (int row = 0; row < 3; ++row)
+    {
+        for (int column = 0; column < 3; ++column)
+        {
+            newExtents[row] += std::abs(matrix[column][row]) * extents[column];
+        }
+    }
+
+    return AABB(center - newExtents, center + newExtents);
+}
+
+BoundingSphere BoundingSphere::Transform(const glm::mat4& matrix) const
+{
+    const glm::vec3 newCenter = glm::vec3(matrix * glm::vec4(center, 1.0f));
+
+    // the squared length of each basis vector is the squared scale along that axis
+    const float scaleX = glm::dot(glm::vec3(matrix[0]), glm::vec3(matrix[0]));
+    const float scaleY = glm::dot(glm::vec3(matrix[1]), glm::vec3(matrix[1]));
+    const float scaleZ = glm::dot(glm::vec3(matrix[2]), glm::vec3(matrix[2]));
+    const float maxScale = std::sqrt(std::max({scaleX, scaleY, scaleZ}));
+
+    return BoundingSphere(newCenter, radius * maxScale);
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
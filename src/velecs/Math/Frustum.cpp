@@ -0,0 +1,85 @@
+/// @file    Frustum.cpp
+/// @author  Matthew Green
+/// @date    2026-10-17 22:57:40
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Math/Frustum.h"
+
+#include <glm/glm.hpp>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+Frustum Frustum::FromMatrix(const glm::mat4& viewProjection)
+{
+    // glm matrices are column major, gather the rows (Gribb & Hartmann)
+    glm::vec4 rows[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+    }
+
+    Frustum frustum;
+    frustum.planes[Plane::Left] = rows[3] + rows[0];
+    frustum.planes[Plane::Right] = rows[3] - rows[0];
+    frustum.planes[Plane::Bottom] = rows[3] + rows[1];
+    frustum.planes[Plane::Top] = rows[3] - rows[1];
+    frustum.planes[Plane::Near] = rows[2]; // Vulkan clip space depth starts at 0, not -w
+    frustum.planes[Plane::Far] = rows[3] - rows[2];
+
+    for (glm::vec4& plane : frustum.planes)
+    {
+        plane /= glm::length(glm::vec3(plane));
+    }
+
+    return frustum;
+}
+
+bool Frustum::Intersects(const BoundingSphere& sphere) const
+{
+    for (const glm::vec4& plane : planes)
+    {
+        if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::Intersects(const AABB& box) const
+{
+    const glm::vec3 center = box.GetCenter();
+    const glm::vec3 extents = box.GetExtents();
+
+    for (const glm::vec4& plane : planes)
+    {
+        // projected radius of the box onto the plane normal
+        const float radius = glm::dot(extents, glm::abs(glm::vec3(plane)));
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
@@ -10,6 +10,10 @@
 
 #include "velecs/Math/GLMUtility.h"
 
+#include <glm/glm.hpp>
+
+#include <cmath>
+
 namespace velecs {
 
 // Public Fields
@@ -34,6 +38,88 @@ std::string GLMUtility::ToString(const glm::mat4& mat)
     return oss.str();  // Return the constructed string
 }
 
+glm::quat GLMUtility::EulerToQuat(const glm::vec3& degrees)
+{
+    const glm::vec3 radians = glm::radians(degrees);
+    return glm::normalize
+    (
+        glm::angleAxis(radians.x, glm::vec3(1.0f, 0.0f, 0.0f)) *
+        glm::angleAxis(radians.y, glm::vec3(0.0f, 1.0f, 0.0f)) *
+        glm::angleAxis(radians.z, glm::vec3(0.0f, 0.0f, 1.0f))
+    );
+}
+
+glm::vec3 GLMUtility::QuatToEuler(const glm::quat& rotation)
+{
+    //the first row of Rx * Ry * Rz is (cy * cz, -cy * sz, sy), glm indexes by column
+    const glm::mat3 m = glm::mat3_cast(rotation);
+    const float cosY = std::hypot(m[0][0], m[1][0]);
+
+    glm::vec3 radians;
+    radians.y = std::atan2(m[2][0], cosY);
+    if (cosY > 1e-6f)
+    {
+        radians.x = std::atan2(-m[2][1], m[2][2]);
+        radians.z = std::atan2(-m[1][0], m[0][0]);
+    }
+    else
+    {
+        //gimbal lock, X and Z turn about the same axis
+        radians.x = std::atan2(m[1][2], m[1][1]);
+        radians.z = 0.0f;
+    }
+
+    return glm::degrees(radians);
+}
+
+glm::mat4 GLMUtility::ComposeTRS(const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale)
+{
+    //glm::mat3_cast spelled out, TransformBatch's kernels repeat these exact operations
+    const float xx = rotation.x * rotation.x;
+    const float yy = rotation.y * rotation.y;
+    const float zz = rotation.z * rotation.z;
+    const float xz = rotation.x * rotation.z;
+    const float xy = rotation.x * rotation.y;
+    const float yz = rotation.y * rotation.z;
+    const float wx = rotation.w * rotation.x;
+    const float wy = rotation.w * rotation.y;
+    const float wz = rotation.w * rotation.z;
+
+    glm::mat4 m;
+    m[0] = glm::vec4((1.0f - 2.0f * (yy + zz)) * scale.x, (2.0f * (xy + wz)) * scale.x, (2.0f * (xz - wy)) * scale.x, 0.0f);
+    m[1] = glm::vec4((2.0f * (xy - wz)) * scale.y, (1.0f - 2.0f * (xx + zz)) * scale.y, (2.0f * (yz + wx)) * scale.y, 0.0f);
+    m[2] = glm::vec4((2.0f * (xz + wy)) * scale.z, (2.0f * (yz - wx)) * scale.z, (1.0f - 2.0f * (xx + yy)) * scale.z, 0.0f);
+    m[3] = glm::vec4(translation, 1.0f);
+    return m;
+}
+
+glm::mat4 GLMUtility::MultiplyAffine(const glm::mat4& a, const glm::mat4& b)
+{
+    glm::mat4 m;
+    for (int column = 0; column < 4; ++column)
+    {
+        for (int row = 0; row < 3; ++row)
+        {
+            m[column][row] = a[0][row] * b[column][0] + a[1][row] * b[column][1] + a[2][row] * b[column][2];
+        }
+        m[column][3] = 0.0f;
+    }
+
+    for (int row = 0; row < 3; ++row)
+    {
+        m[3][row] += a[3][row];
+    }
+    m[3][3] = 1.0f;
+
+    return m;
+}
+
+glm::quat GLMUtility::Slerp(const glm::quat& from, const glm::quat& to, const float t)
+{
+    //glm::slerp negates one end when they are more than half a turn apart, and blends linearly when nearly equal
+    return glm::normalize(glm::slerp(from, to, t));
+}
+
 // Protected Fields
 
 // Protected Methods
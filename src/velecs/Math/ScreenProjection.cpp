@@ -0,0 +1,156 @@
+/// @file    ScreenProjection.cpp
+/// @author  Matthew Green
+/// @date    2026-10-18 06:58:24
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Math/ScreenProjection.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define VELECS_SCREEN_PROJECTION_X64
+#include <immintrin.h>
+#endif
+
+namespace velecs {
+
+static_assert(sizeof(glm::vec3) == 3 * sizeof(float), "ScreenProjection reads glm::vec3 arrays with a stride of 3 floats.");
+static_assert(sizeof(glm::mat4) == 16 * sizeof(float), "ScreenProjection reads glm::mat4 as 16 floats, column by column.");
+static_assert(sizeof(Vec2) == 2 * sizeof(float), "ScreenProjection writes Vec2 arrays as pairs of floats.");
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void ScreenProjection::Project(const glm::mat4& viewProjection, const Vec2 resolution, const size_t count,
+    const glm::vec3* const positions, Vec2* const screenPositions, uint8_t* const clipFlags)
+{
+    Project(viewProjection, resolution, count, reinterpret_cast<const float*>(positions), 3, screenPositions, clipFlags);
+}
+
+void ScreenProjection::Project(const glm::mat4& viewProjection, const Vec2 resolution, const size_t count,
+    const float* const positions, const size_t stride, Vec2* const screenPositions, uint8_t* const clipFlags)
+{
+    size_t i = 0;
+#if defined(VELECS_SCREEN_PROJECTION_X64)
+    //every register holds one element of 4 points, the matrix is broadcast once for the whole batch
+    const float* const matrix = reinterpret_cast<const float*>(&viewProjection);
+    __m128 elements[4][4];
+    for (int column = 0; column < 4; ++column)
+    {
+        for (int row = 0; row < 4; ++row)
+        {
+            elements[column][row] = _mm_set1_ps(matrix[column * 4 + row]);
+        }
+    }
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 halfWidth = _mm_set1_ps(0.5f * resolution.x);
+    const __m128 halfHeight = _mm_set1_ps(0.5f * resolution.y);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const float* const first = positions + i * stride;
+        const __m128 x = _mm_setr_ps(first[0], first[stride], first[2 * stride], first[3 * stride]);
+        const __m128 y = _mm_setr_ps(first[1], first[stride + 1], first[2 * stride + 1], first[3 * stride + 1]);
+        const __m128 z = _mm_setr_ps(first[2], first[stride + 2], first[2 * stride + 2], first[3 * stride + 2]);
+
+        __m128 clip[4];
+        for (int row = 0; row < 4; ++row)
+        {
+            clip[row] = _mm_add_ps
+            (
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(elements[0][row], x), _mm_mul_ps(elements[1][row], y)), _mm_mul_ps(elements[2][row], z)),
+                elements[3][row]
+            );
+        }
+
+        const __m128 w = clip[3];
+        const __m128 negativeW = _mm_sub_ps(zero, w);
+        const __m128 screenX = _mm_mul_ps(_mm_add_ps(_mm_div_ps(clip[0], w), one), halfWidth);
+        const __m128 screenY = _mm_mul_ps(_mm_add_ps(_mm_div_ps(clip[1], w), one), halfHeight);
+
+        float* const out = reinterpret_cast<float*>(screenPositions + i);
+        _mm_storeu_ps(out, _mm_unpacklo_ps(screenX, screenY));
+        _mm_storeu_ps(out + 4, _mm_unpackhi_ps(screenX, screenY));
+
+        if (clipFlags == nullptr)
+        {
+            continue;
+        }
+
+        const int behind = _mm_movemask_ps(_mm_cmple_ps(w, zero));
+        const int left = _mm_movemask_ps(_mm_cmplt_ps(clip[0], negativeW));
+        const int right = _mm_movemask_ps(_mm_cmpgt_ps(clip[0], w));
+        const int top = _mm_movemask_ps(_mm_cmplt_ps(clip[1], negativeW));
+        const int bottom = _mm_movemask_ps(_mm_cmpgt_ps(clip[1], w));
+        const int nearPlane = _mm_movemask_ps(_mm_cmplt_ps(clip[2], zero));
+        const int farPlane = _mm_movemask_ps(_mm_cmpgt_ps(clip[2], w));
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            clipFlags[i + lane] = (uint8_t)
+            (
+                (((behind >> lane) & 1) * Behind) | (((left >> lane) & 1) * Left) | (((right >> lane) & 1) * Right) |
+                (((top >> lane) & 1) * Top) | (((bottom >> lane) & 1) * Bottom) |
+                (((nearPlane >> lane) & 1) * Near) | (((farPlane >> lane) & 1) * Far)
+            );
+        }
+    }
+#endif
+
+    ProjectScalar(viewProjection, resolution, count - i, positions + i * stride, stride,
+        screenPositions + i, clipFlags != nullptr ? clipFlags + i : nullptr);
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void ScreenProjection::ProjectScalar(const glm::mat4& viewProjection, const Vec2 resolution, const size_t count,
+    const float* const positions, const size_t stride, Vec2* const screenPositions, uint8_t* const clipFlags)
+{
+    //same operations in the same order as the SSE loop, a point projects the same wherever it falls in the batch
+    const float* const matrix = reinterpret_cast<const float*>(&viewProjection);
+    const float halfWidth = 0.5f * resolution.x;
+    const float halfHeight = 0.5f * resolution.y;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float* const position = positions + i * stride;
+
+        float clip[4];
+        for (int row = 0; row < 4; ++row)
+        {
+            clip[row] = matrix[row] * position[0] + matrix[4 + row] * position[1] + matrix[8 + row] * position[2] + matrix[12 + row];
+        }
+
+        const float w = clip[3];
+        screenPositions[i].x = (clip[0] / w + 1.0f) * halfWidth;
+        screenPositions[i].y = (clip[1] / w + 1.0f) * halfHeight;
+
+        if (clipFlags == nullptr)
+        {
+            continue;
+        }
+
+        clipFlags[i] = (uint8_t)
+        (
+            (w <= 0.0f ? Behind : Visible) |
+            (clip[0] < -w ? Left : Visible) | (clip[0] > w ? Right : Visible) |
+            (clip[1] < -w ? Top : Visible) | (clip[1] > w ? Bottom : Visible) |
+            (clip[2] < 0.0f ? Near : Visible) | (clip[2] > w ? Far : Visible)
+        );
+    }
+}
+
+} // namespace velecs
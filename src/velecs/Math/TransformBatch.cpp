@@ -0,0 +1,180 @@
+/// @file    TransformBatch.cpp
+/// @author  Matthew Green
+/// @date    2026-10-18 06:40:12
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Math/TransformBatch.h"
+
+#include "velecs/Math/GLMUtility.h"
+
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define VELECS_TRANSFORM_BATCH_X64
+#include "velecs/Math/TransformBatchKernel.h"
+
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace velecs {
+
+#if defined(VELECS_TRANSFORM_BATCH_X64)
+
+/// @struct SSELanes
+/// @brief 4 entities per register, SSE is part of every x86-64 CPU.
+struct SSELanes {
+    using Reg = __m128;
+    static constexpr size_t WIDTH = 4;
+
+    static Reg Broadcast(const float value) { return _mm_set1_ps(value); }
+    static Reg Load(const float* first, const size_t stride) { return _mm_setr_ps(first[0], first[stride], first[2 * stride], first[3 * stride]); }
+    static Reg Add(const Reg a, const Reg b) { return _mm_add_ps(a, b); }
+    static Reg Sub(const Reg a, const Reg b) { return _mm_sub_ps(a, b); }
+    static Reg Mul(const Reg a, const Reg b) { return _mm_mul_ps(a, b); }
+
+    /// @brief Writes one column of 4 matrices, given each of its elements for the 4 of them.
+    static void Store(float* column, Reg x, Reg y, Reg z, Reg w)
+    {
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        _mm_storeu_ps(column, x);
+        _mm_storeu_ps(column + 16, y);
+        _mm_storeu_ps(column + 32, z);
+        _mm_storeu_ps(column + 48, w);
+    }
+};
+
+/// @brief Checks whether the CPU and the operating system support AVX.
+/// @return True if AVX instructions can run.
+static bool DetectAVX()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    //the operating system has to save the upper halves of the registers on context switches
+    return osxsave && avx && (_xgetbv(0) & 0x6) == 0x6;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx");
+#endif
+}
+
+#endif
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void TransformBatch::Compose(const size_t count, const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales,
+    const glm::mat4& parent, const glm::mat4& parentNoScale, glm::mat4* locals, glm::mat4* worlds, glm::mat4* worldsNoScale)
+{
+    switch (ActiveKernel())
+    {
+        case Kernel::AVX:
+            ComposeAVX(count, positions, rotations, scales, parent, parentNoScale, locals, worlds, worldsNoScale);
+            break;
+        case Kernel::SSE:
+            ComposeSSE(count, positions, rotations, scales, parent, parentNoScale, locals, worlds, worldsNoScale);
+            break;
+        default:
+            ComposeScalar(count, positions, rotations, scales, parent, parentNoScale, locals, worlds, worldsNoScale);
+            break;
+    }
+}
+
+TransformBatch::Kernel TransformBatch::GetKernel()
+{
+    return ActiveKernel();
+}
+
+void TransformBatch::SetKernel(const Kernel kernel)
+{
+    if (!IsSupported(kernel))
+    {
+        throw std::runtime_error(std::string("The ") + GetKernelName(kernel) + " transform kernel is not supported on this CPU.");
+    }
+
+    ActiveKernel() = kernel;
+}
+
+bool TransformBatch::IsSupported(const Kernel kernel)
+{
+#if defined(VELECS_TRANSFORM_BATCH_X64)
+    static const bool avx = IsAVXBuilt() && DetectAVX();
+
+    switch (kernel)
+    {
+        case Kernel::AVX:
+            return avx;
+        default:
+            return true;
+    }
+#else
+    return kernel == Kernel::Scalar;
+#endif
+}
+
+const char* TransformBatch::GetKernelName(const Kernel kernel)
+{
+    switch (kernel)
+    {
+        case Kernel::AVX:
+            return "AVX";
+        case Kernel::SSE:
+            return "SSE";
+        default:
+            return "Scalar";
+    }
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+TransformBatch::Kernel& TransformBatch::ActiveKernel()
+{
+    static Kernel kernel = IsSupported(Kernel::AVX) ? Kernel::AVX : IsSupported(Kernel::SSE) ? Kernel::SSE : Kernel::Scalar;
+    return kernel;
+}
+
+void TransformBatch::ComposeScalar(const size_t count, const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales,
+    const glm::mat4& parent, const glm::mat4& parentNoScale, glm::mat4* locals, glm::mat4* worlds, glm::mat4* worldsNoScale)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        locals[i] = GLMUtility::ComposeTRS(positions[i], rotations[i], scales[i]);
+        worlds[i] = GLMUtility::MultiplyAffine(parent, locals[i]);
+        worldsNoScale[i] = GLMUtility::MultiplyAffine(parentNoScale, GLMUtility::ComposeTRS(positions[i], rotations[i], glm::vec3(1.0f)));
+    }
+}
+
+void TransformBatch::ComposeSSE(const size_t count, const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales,
+    const glm::mat4& parent, const glm::mat4& parentNoScale, glm::mat4* locals, glm::mat4* worlds, glm::mat4* worldsNoScale)
+{
+    size_t composed = 0;
+#if defined(VELECS_TRANSFORM_BATCH_X64)
+    composed = ComposeLanes<SSELanes>(count, positions, rotations, scales, parent, parentNoScale, locals, worlds, worldsNoScale);
+#endif
+
+    ComposeScalar(count - composed, positions + composed, rotations + composed, scales + composed,
+        parent, parentNoScale, locals + composed, worlds + composed, worldsNoScale + composed);
+}
+
+} // namespace velecs
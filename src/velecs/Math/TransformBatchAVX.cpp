@@ -0,0 +1,100 @@
+/// @file    TransformBatchAVX.cpp
+/// @author  Matthew Green
+/// @date    2026-10-18 06:40:12
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+// Built with AVX enabled, nothing here may run before TransformBatch checked the CPU supports it.
+
+#include "velecs/Math/TransformBatch.h"
+
+#if defined(__AVX__)
+#include "velecs/Math/TransformBatchKernel.h"
+
+#include <immintrin.h>
+#endif
+
+namespace velecs {
+
+#if defined(__AVX__)
+
+/// @struct AVXLanes
+/// @brief 8 entities per register.
+struct AVXLanes {
+    using Reg = __m256;
+    static constexpr size_t WIDTH = 8;
+
+    static Reg Broadcast(const float value) { return _mm256_set1_ps(value); }
+    static Reg Add(const Reg a, const Reg b) { return _mm256_add_ps(a, b); }
+    static Reg Sub(const Reg a, const Reg b) { return _mm256_sub_ps(a, b); }
+    static Reg Mul(const Reg a, const Reg b) { return _mm256_mul_ps(a, b); }
+
+    static Reg Load(const float* first, const size_t stride)
+    {
+        return _mm256_setr_ps(first[0], first[stride], first[2 * stride], first[3 * stride],
+            first[4 * stride], first[5 * stride], first[6 * stride], first[7 * stride]);
+    }
+
+    /// @brief Writes one column of 8 matrices, given each of its elements for the 8 of them.
+    static void Store(float* column, const Reg x, const Reg y, const Reg z, const Reg w)
+    {
+        //each 128 bit half holds 4 of the matrices, transposed like the SSE kernel does
+        for (int half = 0; half < 2; ++half)
+        {
+            __m128 x4 = half == 0 ? _mm256_castps256_ps128(x) : _mm256_extractf128_ps(x, 1);
+            __m128 y4 = half == 0 ? _mm256_castps256_ps128(y) : _mm256_extractf128_ps(y, 1);
+            __m128 z4 = half == 0 ? _mm256_castps256_ps128(z) : _mm256_extractf128_ps(z, 1);
+            __m128 w4 = half == 0 ? _mm256_castps256_ps128(w) : _mm256_extractf128_ps(w, 1);
+            _MM_TRANSPOSE4_PS(x4, y4, z4, w4);
+
+            float* const quarter = column + 64 * half;
+            _mm_storeu_ps(quarter, x4);
+            _mm_storeu_ps(quarter + 16, y4);
+            _mm_storeu_ps(quarter + 32, z4);
+            _mm_storeu_ps(quarter + 48, w4);
+        }
+    }
+};
+
+#endif
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void TransformBatch::ComposeAVX(const size_t count, const glm::vec3* positions, const glm::quat* rotations, const glm::vec3* scales,
+    const glm::mat4& parent, const glm::mat4& parentNoScale, glm::mat4* locals, glm::mat4* worlds, glm::mat4* worldsNoScale)
+{
+    size_t composed = 0;
+#if defined(__AVX__)
+    composed = ComposeLanes<AVXLanes>(count, positions, rotations, scales, parent, parentNoScale, locals, worlds, worldsNoScale);
+#endif
+
+    ComposeScalar(count - composed, positions + composed, rotations + composed, scales + composed,
+        parent, parentNoScale, locals + composed, worlds + composed, worldsNoScale + composed);
+}
+
+bool TransformBatch::IsAVXBuilt()
+{
+#if defined(__AVX__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace velecs
@@ -0,0 +1,112 @@
+/// @file    RangeAllocator.cpp
+/// @author  Matthew Green
+/// @date    2026-10-17 20:33:47
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Memory/RangeAllocator.h"
+
+#include <stdexcept>
+#include <iterator>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+RangeAllocator::RangeAllocator(const uint32_t capacity)
+    : capacity(capacity)
+{
+    if (capacity > 0)
+    {
+        freeRanges.emplace(0, capacity);
+    }
+}
+
+// Public Methods
+
+bool RangeAllocator::TryAllocate(const uint32_t size, uint32_t& outOffset)
+{
+    if (size == 0)
+    {
+        return false;
+    }
+
+    for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it)
+    {
+        const uint32_t rangeOffset = it->first;
+        const uint32_t rangeSize = it->second;
+        if (rangeSize < size)
+        {
+            continue;
+        }
+
+        freeRanges.erase(it);
+        if (rangeSize > size)
+        {
+            // keep the tail of the range free
+            freeRanges.emplace(rangeOffset + size, rangeSize - size);
+        }
+
+        used += size;
+        outOffset = rangeOffset;
+        return true;
+    }
+
+    return false;
+}
+
+void RangeAllocator::Free(const uint32_t offset, const uint32_t size)
+{
+    if (size == 0)
+    {
+        return;
+    }
+
+    if (offset + size > capacity || size > used)
+    {
+        throw std::runtime_error("RangeAllocator::Free called with a range that was never allocated.");
+    }
+
+    uint32_t newOffset = offset;
+    uint32_t newSize = size;
+
+    auto next = freeRanges.lower_bound(offset);
+
+    // merge with the free range right after this one
+    if (next != freeRanges.end() && offset + size == next->first)
+    {
+        newSize += next->second;
+        next = freeRanges.erase(next);
+    }
+
+    // merge with the free range right before this one
+    if (next != freeRanges.begin())
+    {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == offset)
+        {
+            newOffset = previous->first;
+            newSize += previous->second;
+            freeRanges.erase(previous);
+        }
+    }
+
+    freeRanges.emplace(newOffset, newSize);
+    used -= size;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
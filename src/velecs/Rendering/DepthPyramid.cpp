@@ -0,0 +1,389 @@
+/// @file    DepthPyramid.cpp
+/// @author  Matthew Green
+/// @date    2026-10-18 03:06:14
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/DepthPyramid.h"
+
+#include "velecs/Rendering/ShaderModule.h"
+#include "velecs/Engine/vk_initializers.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void DepthPyramid::Init(VkDevice device, VmaAllocator allocator, VkPipelineCache pipelineCache /* = VK_NULL_HANDLE*/)
+{
+    this->device = device;
+    this->allocator = allocator;
+
+    //only read with texelFetch, the sampler is required by the descriptor type but never filters
+    VkSamplerCreateInfo samplerInfo = {};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = VK_FILTER_NEAREST;
+    samplerInfo.minFilter = VK_FILTER_NEAREST;
+    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.maxLod = (float)MAX_LEVELS;
+
+    if (vkCreateSampler(device, &samplerInfo, nullptr, &sampler) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the depth pyramid sampler.");
+    }
+
+    //the level read from and the level written to
+    VkDescriptorSetLayoutBinding reduceBindings[2] = {};
+    reduceBindings[0].binding = 0;
+    reduceBindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    reduceBindings[0].descriptorCount = 1;
+    reduceBindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    reduceBindings[1].binding = 1;
+    reduceBindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    reduceBindings[1].descriptorCount = 1;
+    reduceBindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    VkDescriptorSetLayoutCreateInfo reduceLayoutInfo = {};
+    reduceLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    reduceLayoutInfo.bindingCount = 2;
+    reduceLayoutInfo.pBindings = reduceBindings;
+
+    if (vkCreateDescriptorSetLayout(device, &reduceLayoutInfo, nullptr, &reduceSetLayout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the depth pyramid reduction set layout.");
+    }
+
+    VkDescriptorSetLayoutBinding sampleBinding = reduceBindings[0];
+
+    VkDescriptorSetLayoutCreateInfo sampleLayoutInfo = {};
+    sampleLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    sampleLayoutInfo.bindingCount = 1;
+    sampleLayoutInfo.pBindings = &sampleBinding;
+
+    if (vkCreateDescriptorSetLayout(device, &sampleLayoutInfo, nullptr, &sampleSetLayout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the depth pyramid set layout.");
+    }
+
+    VkPushConstantRange pushConstant = {};
+    pushConstant.offset = 0;
+    pushConstant.size = sizeof(ReduceConstants);
+    pushConstant.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    VkPipelineLayoutCreateInfo layoutInfo = vkinit::pipeline_layout_create_info();
+    layoutInfo.setLayoutCount = 1;
+    layoutInfo.pSetLayouts = &reduceSetLayout;
+    layoutInfo.pushConstantRangeCount = 1;
+    layoutInfo.pPushConstantRanges = &pushConstant;
+
+    if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &reducePipelineLayout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the depth pyramid pipeline layout.");
+    }
+
+    const ShaderModule reduceShader = ShaderModule::CreateCompShader(device, "GPUCulling/DepthReduce.comp.spv");
+
+    VkComputePipelineCreateInfo pipelineInfo = {};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage = reduceShader.pipelineShaderStageCreateInfo;
+    pipelineInfo.layout = reducePipelineLayout;
+
+    if (vkCreateComputePipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &reducePipeline) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the depth pyramid reduction pipeline.");
+    }
+}
+
+void DepthPyramid::Cleanup()
+{
+    if (device == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    DeletionQueue retired;
+    Retire(retired);
+    retired.Flush();
+
+    vkDestroyPipeline(device, reducePipeline, nullptr);
+    vkDestroyPipelineLayout(device, reducePipelineLayout, nullptr);
+    vkDestroyDescriptorSetLayout(device, sampleSetLayout, nullptr);
+    vkDestroyDescriptorSetLayout(device, reduceSetLayout, nullptr);
+    vkDestroySampler(device, sampler, nullptr);
+
+    reducePipeline = VK_NULL_HANDLE;
+    reducePipelineLayout = VK_NULL_HANDLE;
+    sampleSetLayout = VK_NULL_HANDLE;
+    reduceSetLayout = VK_NULL_HANDLE;
+    sampler = VK_NULL_HANDLE;
+    device = VK_NULL_HANDLE;
+}
+
+void DepthPyramid::Resize(VkImageView depthImageView, const VkExtent2D depthExtent, DeletionQueue& retired)
+{
+    //frames in flight may still read the old pyramid
+    Retire(retired);
+
+    this->depthExtent = depthExtent;
+
+    //every level rounds up, so the last texel of an odd row or column still covers the texels below it
+    levelCount = 0;
+    VkExtent2D extent = depthExtent;
+    do
+    {
+        extent = { std::max((extent.width + 1) / 2, 1u), std::max((extent.height + 1) / 2, 1u) };
+        levelExtents[levelCount++] = extent;
+    }
+    while ((extent.width > 1 || extent.height > 1) && levelCount < MAX_LEVELS);
+
+    VkImageCreateInfo imageInfo = vkinit::image_create_info(VK_FORMAT_R32_SFLOAT, VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, { levelExtents[0].width, levelExtents[0].height, 1 });
+    imageInfo.mipLevels = levelCount;
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+    if (vmaCreateImage(allocator, &imageInfo, &allocInfo, &image._image, &image._allocation, nullptr) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the depth pyramid image.");
+    }
+
+    VkImageViewCreateInfo viewInfo = vkinit::imageview_create_info(VK_FORMAT_R32_SFLOAT, image._image, VK_IMAGE_ASPECT_COLOR_BIT);
+    viewInfo.subresourceRange.levelCount = levelCount;
+    if (vkCreateImageView(device, &viewInfo, nullptr, &sampleView) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the depth pyramid view.");
+    }
+
+    viewInfo.subresourceRange.levelCount = 1;
+    for (uint32_t level = 0; level < levelCount; ++level)
+    {
+        viewInfo.subresourceRange.baseMipLevel = level;
+        if (vkCreateImageView(device, &viewInfo, nullptr, &levelViews[level]) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create a depth pyramid level view.");
+        }
+    }
+
+    //the sets point at this size's views, a new pool lets the old one retire with them
+    const VkDescriptorPoolSize poolSizes[] =
+    {
+        { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, levelCount + 1 },
+        { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, levelCount },
+    };
+
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = levelCount + 1;
+    poolInfo.poolSizeCount = 2;
+    poolInfo.pPoolSizes = poolSizes;
+
+    if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the depth pyramid descriptor pool.");
+    }
+
+    std::array<VkDescriptorSetLayout, MAX_LEVELS> reduceLayouts;
+    reduceLayouts.fill(reduceSetLayout);
+
+    VkDescriptorSetAllocateInfo setInfo = {};
+    setInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    setInfo.descriptorPool = descriptorPool;
+    setInfo.descriptorSetCount = levelCount;
+    setInfo.pSetLayouts = reduceLayouts.data();
+
+    if (vkAllocateDescriptorSets(device, &setInfo, reduceSets.data()) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to allocate the depth pyramid reduction sets.");
+    }
+
+    setInfo.descriptorSetCount = 1;
+    setInfo.pSetLayouts = &sampleSetLayout;
+
+    if (vkAllocateDescriptorSets(device, &setInfo, &sampleSet) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to allocate the depth pyramid set.");
+    }
+
+    //level 0 reads the depth image, every other level reads the one before it
+    std::array<VkDescriptorImageInfo, MAX_LEVELS * 2 + 1> imageInfos{};
+    std::array<VkWriteDescriptorSet, MAX_LEVELS * 2 + 1> writes{};
+    uint32_t writeCount = 0;
+
+    auto addWrite = [&](VkDescriptorSet set, uint32_t binding, VkDescriptorType type, VkImageView view, VkImageLayout layout)
+    {
+        imageInfos[writeCount] = { sampler, view, layout };
+
+        VkWriteDescriptorSet& write = writes[writeCount];
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = set;
+        write.dstBinding = binding;
+        write.descriptorCount = 1;
+        write.descriptorType = type;
+        write.pImageInfo = &imageInfos[writeCount];
+
+        ++writeCount;
+    };
+
+    for (uint32_t level = 0; level < levelCount; ++level)
+    {
+        if (level == 0)
+        {
+            addWrite(reduceSets[level], 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, depthImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        }
+        else
+        {
+            addWrite(reduceSets[level], 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, levelViews[level - 1], VK_IMAGE_LAYOUT_GENERAL);
+        }
+        addWrite(reduceSets[level], 1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, levelViews[level], VK_IMAGE_LAYOUT_GENERAL);
+    }
+    addWrite(sampleSet, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, sampleView, VK_IMAGE_LAYOUT_GENERAL);
+
+    vkUpdateDescriptorSets(device, writeCount, writes.data(), 0, nullptr);
+}
+
+bool DepthPyramid::Build(VkCommandBuffer cmd, VkImage depthImage, const bool hasDepth)
+{
+    //the previous content is always discarded, the last frame's culling has to be done reading it first
+    VkImageMemoryBarrier pyramidBarrier = {};
+    pyramidBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    pyramidBarrier.srcAccessMask = 0;
+    pyramidBarrier.dstAccessMask = hasDepth ? VK_ACCESS_SHADER_WRITE_BIT : VK_ACCESS_SHADER_READ_BIT;
+    pyramidBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    pyramidBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    pyramidBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    pyramidBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    pyramidBarrier.image = image._image;
+    pyramidBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, levelCount, 0, 1 };
+
+    if (!hasDepth)
+    {
+        //nothing to reduce, the culling shader still needs its descriptor in the layout it was written with
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &pyramidBarrier);
+        return false;
+    }
+
+    //the previous frame's depth writes have to land before they are reduced
+    VkImageMemoryBarrier depthBarrier = {};
+    depthBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    depthBarrier.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    depthBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    depthBarrier.oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    depthBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    depthBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    depthBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    depthBarrier.image = depthImage;
+    depthBarrier.subresourceRange = { VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1 };
+
+    const VkImageMemoryBarrier beginBarriers[] = { depthBarrier, pyramidBarrier };
+    vkCmdPipelineBarrier
+    (
+        cmd,
+        VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0, 0, nullptr, 0, nullptr, 2, beginBarriers
+    );
+
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, reducePipeline);
+
+    VkExtent2D sourceExtent = depthExtent;
+    for (uint32_t level = 0; level < levelCount; ++level)
+    {
+        const VkExtent2D& levelExtent = levelExtents[level];
+
+        ReduceConstants constants = {};
+        constants.sourceWidth = (int32_t)sourceExtent.width;
+        constants.sourceHeight = (int32_t)sourceExtent.height;
+        constants.destinationWidth = (int32_t)levelExtent.width;
+        constants.destinationHeight = (int32_t)levelExtent.height;
+
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, reducePipelineLayout, 0, 1, &reduceSets[level], 0, nullptr);
+        vkCmdPushConstants(cmd, reducePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ReduceConstants), &constants);
+        vkCmdDispatch(cmd, (levelExtent.width + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, (levelExtent.height + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1);
+
+        //the next level, or the culling shader after the last one, reads what was just written
+        VkMemoryBarrier levelBarrier = {};
+        levelBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        levelBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        levelBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &levelBarrier, 0, nullptr, 0, nullptr);
+
+        sourceExtent = levelExtent;
+    }
+
+    //hand the depth image back to the main render pass, which clears it after the reduction has read it
+    depthBarrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    depthBarrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    depthBarrier.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    depthBarrier.newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    vkCmdPipelineBarrier
+    (
+        cmd,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+        0, 0, nullptr, 0, nullptr, 1, &depthBarrier
+    );
+
+    return true;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void DepthPyramid::Retire(DeletionQueue& retired)
+{
+    if (image._image == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    const VkDevice device = this->device;
+    const VmaAllocator allocator = this->allocator;
+    const AllocatedImage oldImage = image;
+    const VkImageView oldSampleView = sampleView;
+    const std::array<VkImageView, MAX_LEVELS> oldLevelViews = levelViews;
+    const uint32_t oldLevelCount = levelCount;
+    const VkDescriptorPool oldPool = descriptorPool;
+
+    retired.PushDeletor
+    (
+        [=]()
+        {
+            //destroying the pool frees its sets
+            vkDestroyDescriptorPool(device, oldPool, nullptr);
+            for (uint32_t level = 0; level < oldLevelCount; ++level)
+            {
+                vkDestroyImageView(device, oldLevelViews[level], nullptr);
+            }
+            vkDestroyImageView(device, oldSampleView, nullptr);
+            vmaDestroyImage(allocator, oldImage._image, oldImage._allocation);
+        }
+    );
+
+    image = AllocatedImage();
+    sampleView = VK_NULL_HANDLE;
+    levelViews.fill(VK_NULL_HANDLE);
+    descriptorPool = VK_NULL_HANDLE;
+    reduceSets.fill(VK_NULL_HANDLE);
+    sampleSet = VK_NULL_HANDLE;
+    levelCount = 0;
+}
+
+} // namespace velecs
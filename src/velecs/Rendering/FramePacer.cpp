@@ -0,0 +1,84 @@
+/// @file    FramePacer.cpp
+/// @author  Matthew Green
+/// @date    2026-10-18 02:27:53
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/FramePacer.h"
+
+#include <thread>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void FramePacer::Init(const uint32_t framesInFlight)
+{
+    inputSampleTimes.assign(framesInFlight + 1, Clock::time_point());
+}
+
+void FramePacer::WaitForInputSample() const
+{
+    if (intervalMs <= 0.0f || latencyMs <= 0.0f)
+    {
+        return;
+    }
+
+    //the next frame is expected one interval after the last one, it needs latencyMs to get there once input is sampled
+    const float slackMs = intervalMs - latencyMs - SAFETY_MARGIN_MS;
+    if (slackMs <= 0.0f)
+    {
+        return;
+    }
+
+    const Clock::time_point deadline = lastCompletion + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float, std::milli>(slackMs));
+    std::this_thread::sleep_until(deadline);
+}
+
+void FramePacer::OnInputSampled(const uint32_t frameNumber)
+{
+    inputSampleTimes[frameNumber % inputSampleTimes.size()] = Clock::now();
+}
+
+void FramePacer::OnFrameCompleted(const uint32_t frameNumber)
+{
+    Clock::time_point& inputSampleTime = inputSampleTimes[frameNumber % inputSampleTimes.size()];
+    if (inputSampleTime == Clock::time_point())
+    {
+        return; // already measured, or never sampled
+    }
+
+    const Clock::time_point now = Clock::now();
+
+    latencyMs = Smooth(latencyMs, std::chrono::duration<float, std::milli>(now - inputSampleTime).count());
+    if (lastCompletion != Clock::time_point())
+    {
+        intervalMs = Smooth(intervalMs, std::chrono::duration<float, std::milli>(now - lastCompletion).count());
+    }
+
+    lastCompletion = now;
+    inputSampleTime = Clock::time_point();
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+float FramePacer::Smooth(const float average, const float sample)
+{
+    return average <= 0.0f ? sample : average + (sample - average) * SMOOTHING;
+}
+
+} // namespace velecs
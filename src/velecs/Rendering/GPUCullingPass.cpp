@@ -0,0 +1,573 @@
+/// @file    GPUCullingPass.cpp
+/// @author  Matthew Green
+/// @date    2026-10-17 23:41:52
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/GPUCullingPass.h"
+
+#include "velecs/Rendering/ShaderModule.h"
+#include "velecs/Engine/vk_initializers.h"
+
+#include "velecs/Rendering/MeshArena.h"
+#include "velecs/ECS/Components/Rendering/SimpleMesh.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace velecs {
+
+static_assert(sizeof(GPUCullingPass::ObjectData) == 112, "ObjectData must match the std430 layout of the shaders.");
+static_assert(sizeof(GPUCullingPass::DrawBatch) == 32, "DrawBatch must match the std430 layout of the shaders.");
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void GPUCullingPass::Init
+(
+    VkDevice device,
+    VmaAllocator allocator,
+    const uint32_t framesInFlight,
+    PFN_vkCmdDrawIndexedIndirectCount drawIndexedIndirectCount,
+    const bool multiDrawIndirect,
+    VkDescriptorSetLayout cameraSetLayout,
+    VkDescriptorSetLayout depthPyramidSetLayout,
+    VkPipelineCache pipelineCache
+)
+{
+    this->device = device;
+    this->allocator = allocator;
+    this->drawIndexedIndirectCount = drawIndexedIndirectCount;
+    this->multiDrawIndirect = multiDrawIndirect;
+    this->occlusionEnabled = depthPyramidSetLayout != VK_NULL_HANDLE;
+
+    //objects, batches, visible objects, draw commands and draw counts
+    constexpr uint32_t bindingCount = 5;
+
+    std::array<VkDescriptorSetLayoutBinding, bindingCount> bindings{};
+    for (uint32_t i = 0; i < bindingCount; ++i)
+    {
+        bindings[i].binding = i;
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT;
+    }
+
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo = {};
+    setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setLayoutInfo.bindingCount = bindingCount;
+    setLayoutInfo.pBindings = bindings.data();
+
+    if (vkCreateDescriptorSetLayout(device, &setLayoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the GPU culling descriptor set layout.");
+    }
+
+    VkDescriptorPoolSize poolSize = {};
+    poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSize.descriptorCount = bindingCount * framesInFlight;
+
+    VkDescriptorPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = framesInFlight;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+
+    if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the GPU culling descriptor pool.");
+    }
+
+    frames.resize(framesInFlight);
+    for (FrameResources& frame : frames)
+    {
+        VkDescriptorSetAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &descriptorSetLayout;
+
+        if (vkAllocateDescriptorSets(device, &allocInfo, &frame.descriptorSet) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to allocate a GPU culling descriptor set.");
+        }
+
+        frame.countBuffer = CreateBuffer
+        (
+            MAX_PIPELINES * sizeof(uint32_t),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            false
+        );
+    }
+
+    VkPushConstantRange cullPushConstant = {};
+    cullPushConstant.offset = 0;
+    cullPushConstant.size = sizeof(CullConstants);
+    cullPushConstant.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    //the occlusion test also reads the previous view-projection from set 1 and the depth pyramid from set 2
+    const VkDescriptorSetLayout cullSetLayouts[] = { descriptorSetLayout, cameraSetLayout, depthPyramidSetLayout };
+
+    VkPipelineLayoutCreateInfo cullLayoutInfo = vkinit::pipeline_layout_create_info();
+    cullLayoutInfo.setLayoutCount = occlusionEnabled ? 3 : 1;
+    cullLayoutInfo.pSetLayouts = cullSetLayouts;
+    cullLayoutInfo.pushConstantRangeCount = 1;
+    cullLayoutInfo.pPushConstantRanges = &cullPushConstant;
+
+    if (vkCreatePipelineLayout(device, &cullLayoutInfo, nullptr, &cullPipelineLayout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the GPU culling pipeline layout.");
+    }
+
+    //the indirect vertex shaders read the objects from set 0 and the frame's CameraData from set 1
+    const VkDescriptorSetLayout drawSetLayouts[] = { descriptorSetLayout, cameraSetLayout };
+
+    VkPipelineLayoutCreateInfo drawLayoutInfo = vkinit::pipeline_layout_create_info();
+    drawLayoutInfo.setLayoutCount = 2;
+    drawLayoutInfo.pSetLayouts = drawSetLayouts;
+
+    if (vkCreatePipelineLayout(device, &drawLayoutInfo, nullptr, &drawPipelineLayout) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the indirect draw pipeline layout.");
+    }
+
+    const ShaderModule cullShader = ShaderModule::CreateCompShader(device, occlusionEnabled ? "GPUCulling/CullOcclusion.comp.spv" : "GPUCulling/Cull.comp.spv");
+    const ShaderModule buildDrawsShader = ShaderModule::CreateCompShader(device, "GPUCulling/BuildDraws.comp.spv");
+
+    std::array<VkComputePipelineCreateInfo, 2> pipelineInfos{};
+    pipelineInfos[0].sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfos[0].stage = cullShader.pipelineShaderStageCreateInfo;
+    pipelineInfos[0].layout = cullPipelineLayout;
+    pipelineInfos[1].sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfos[1].stage = buildDrawsShader.pipelineShaderStageCreateInfo;
+    pipelineInfos[1].layout = cullPipelineLayout;
+
+    std::array<VkPipeline, 2> computePipelines{};
+    if (vkCreateComputePipelines(device, pipelineCache, (uint32_t)pipelineInfos.size(), pipelineInfos.data(), nullptr, computePipelines.data()) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the GPU culling compute pipelines.");
+    }
+    cullPipeline = computePipelines[0];
+    buildDrawsPipeline = computePipelines[1];
+}
+
+void GPUCullingPass::Cleanup()
+{
+    for (FrameResources& frame : frames)
+    {
+        DestroyBuffer(frame.objectBuffer);
+        DestroyBuffer(frame.batchBuffer);
+        DestroyBuffer(frame.visibleBuffer);
+        DestroyBuffer(frame.commandBuffer);
+        DestroyBuffer(frame.countBuffer);
+    }
+    frames.clear();
+
+    if (device == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    vkDestroyPipeline(device, cullPipeline, nullptr);
+    vkDestroyPipeline(device, buildDrawsPipeline, nullptr);
+    vkDestroyPipelineLayout(device, cullPipelineLayout, nullptr);
+    vkDestroyPipelineLayout(device, drawPipelineLayout, nullptr);
+
+    //destroying the pool frees its sets
+    vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
+
+    cullPipeline = VK_NULL_HANDLE;
+    buildDrawsPipeline = VK_NULL_HANDLE;
+    cullPipelineLayout = VK_NULL_HANDLE;
+    drawPipelineLayout = VK_NULL_HANDLE;
+    descriptorPool = VK_NULL_HANDLE;
+    descriptorSetLayout = VK_NULL_HANDLE;
+    device = VK_NULL_HANDLE;
+}
+
+void GPUCullingPass::BeginFrame(const uint32_t frameIndex)
+{
+    currentFrame = frameIndex;
+
+    pipelines.clear();
+    batches.clear();
+    objectCount = 0;
+}
+
+uint32_t GPUCullingPass::GetBatch(const VkPipeline pipeline, const SimpleMesh& mesh, const uint32_t lod)
+{
+    const MeshRange range = mesh.GetLODRange(lod);
+
+    //only a handful of pipelines exist, a linear search beats hashing
+    uint32_t pipelineIndex = 0;
+    while (pipelineIndex < pipelines.size() && (pipelines[pipelineIndex].pipeline != pipeline || pipelines[pipelineIndex].indexType != range.indexType))
+    {
+        ++pipelineIndex;
+    }
+
+    if (pipelineIndex == pipelines.size())
+    {
+        if (pipelines.size() == MAX_PIPELINES)
+        {
+            throw std::runtime_error("GPUCullingPass supports at most " + std::to_string(MAX_PIPELINES) + " pipelines per frame.");
+        }
+
+        PipelineBatches& newPipeline = pipelines.emplace_back();
+        newPipeline.pipeline = pipeline;
+        newPipeline.indexType = range.indexType;
+    }
+
+    //levels never overlap in the arena, their first index identifies them among meshes of the same index type
+    auto [it, inserted] = pipelines[pipelineIndex].batches.try_emplace(range.firstIndex, (uint32_t)batches.size());
+    if (inserted)
+    {
+        BatchInfo& batch = batches.emplace_back();
+        batch.range = range;
+        batch.pipelineIndex = pipelineIndex;
+    }
+    return it->second;
+}
+
+void GPUCullingPass::ReserveObjects(const uint32_t count)
+{
+    FrameResources& frame = frames[currentFrame];
+
+    const uint32_t required = objectCount + count;
+    if (required <= frame.objectCapacity)
+    {
+        return;
+    }
+
+    const uint32_t newCapacity = GrowCapacity(frame.objectCapacity, required);
+
+    void* mapped = nullptr;
+    AllocatedBuffer newBuffer = CreateBuffer(newCapacity * sizeof(ObjectData), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, true, &mapped);
+
+    if (objectCount > 0)
+    {
+        memcpy(mapped, frame.mappedObjects, objectCount * sizeof(ObjectData));
+    }
+
+    //the GPU finished with this frame's buffers before the frame started gathering again
+    DestroyBuffer(frame.objectBuffer);
+
+    frame.objectBuffer = newBuffer;
+    frame.mappedObjects = static_cast<ObjectData*>(mapped);
+    frame.objectCapacity = newCapacity;
+}
+
+void GPUCullingPass::AddObject(const uint32_t batchIndex, const glm::mat4& world, const glm::vec4& color, const BoundingSphere& boundingSphere)
+{
+    if (objectCount == frames[currentFrame].objectCapacity)
+    {
+        ReserveObjects(1);
+    }
+
+    ObjectData& object = frames[currentFrame].mappedObjects[objectCount];
+    object.world = world;
+    object.color = color;
+    object.boundingSphere = glm::vec4(boundingSphere.center, boundingSphere.radius);
+    object.batchIndex = batchIndex;
+
+    ++batches[batchIndex].objectCount;
+    ++objectCount;
+}
+
+void GPUCullingPass::RecordCulling(VkCommandBuffer cmd, const Frustum& frustum, VkDescriptorSet cameraSet, const DepthPyramid* depthPyramid, const bool testOcclusion)
+{
+    if (objectCount == 0)
+    {
+        return;
+    }
+
+    FrameResources& frame = frames[currentFrame];
+
+    ReserveGPUBuffers(frame);
+
+    //commands of a pipeline are contiguous so each pipeline is a single indirect draw
+    uint32_t commandCount = 0;
+    for (PipelineBatches& pipeline : pipelines)
+    {
+        pipeline.firstCommand = commandCount;
+        commandCount += (uint32_t)pipeline.batches.size();
+    }
+
+    std::vector<uint32_t> pipelineBatchCounts(pipelines.size(), 0);
+    uint32_t firstInstance = 0;
+    for (uint32_t i = 0; i < batches.size(); ++i)
+    {
+        const BatchInfo& info = batches[i];
+        const PipelineBatches& pipeline = pipelines[info.pipelineIndex];
+
+        DrawBatch& batch = frame.mappedBatches[i];
+        batch.indexCount = info.range.indexCount;
+        batch.firstIndex = info.range.firstIndex;
+        batch.vertexOffset = info.range.vertexOffset;
+        batch.firstInstance = firstInstance;
+        batch.instanceCount = 0;
+        batch.pipelineIndex = info.pipelineIndex;
+        batch.pipelineFirstCommand = pipeline.firstCommand;
+        batch.commandIndex = pipeline.firstCommand + pipelineBatchCounts[info.pipelineIndex]++;
+
+        firstInstance += info.objectCount;
+    }
+
+    //the memory type is only host coherent if the allocator picked such a type
+    vmaFlushAllocation(allocator, frame.objectBuffer._allocation, 0, VK_WHOLE_SIZE);
+    vmaFlushAllocation(allocator, frame.batchBuffer._allocation, 0, VK_WHOLE_SIZE);
+
+    UpdateDescriptorSet(frame);
+
+    vkCmdFillBuffer(cmd, frame.countBuffer._buffer, 0, MAX_PIPELINES * sizeof(uint32_t), 0);
+
+    VkMemoryBarrier clearBarrier = {};
+    clearBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    clearBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    clearBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &clearBarrier, 0, nullptr, 0, nullptr);
+
+    CullConstants constants = {};
+    for (uint32_t i = 0; i < Frustum::Plane::Count; ++i)
+    {
+        constants.frustumPlanes[i] = frustum.planes[i];
+    }
+    constants.compact = drawIndexedIndirectCount != nullptr ? 1 : 0;
+
+    if (occlusionEnabled)
+    {
+        if (depthPyramid == nullptr)
+        {
+            throw std::runtime_error("GPUCullingPass::RecordCulling requires the depth pyramid while occlusion culling is enabled.");
+        }
+
+        //the sets are used by the shader either way, the push constant alone decides whether the pyramid is tested
+        constants.occlusion = testOcclusion ? 1 : 0;
+        constants.depthWidth = (float)depthPyramid->GetDepthExtent().width;
+        constants.depthHeight = (float)depthPyramid->GetDepthExtent().height;
+
+        const VkDescriptorSet occlusionSets[] = { cameraSet, depthPyramid->GetSet() };
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipelineLayout, 1, 2, occlusionSets, 0, nullptr);
+    }
+
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipelineLayout, 0, 1, &frame.descriptorSet, 0, nullptr);
+
+    //one invocation per object, appending the visible ones to their batch
+    constants.count = objectCount;
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipeline);
+    vkCmdPushConstants(cmd, cullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullConstants), &constants);
+    vkCmdDispatch(cmd, (objectCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+
+    VkMemoryBarrier cullBarrier = {};
+    cullBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    cullBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    cullBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &cullBarrier, 0, nullptr, 0, nullptr);
+
+    //one invocation per batch, turning the instance counts into draw commands
+    constants.count = (uint32_t)batches.size();
+    vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, buildDrawsPipeline);
+    vkCmdPushConstants(cmd, cullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullConstants), &constants);
+    vkCmdDispatch(cmd, (constants.count + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+
+    VkMemoryBarrier drawBarrier = {};
+    drawBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    drawBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    drawBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 1, &drawBarrier, 0, nullptr, 0, nullptr);
+}
+
+void GPUCullingPass::RecordDraws(VkCommandBuffer cmd, VkDescriptorSet cameraSet, const MeshArena& meshArena, RenderStats& stats) const
+{
+    stats.gpuDrivenObjects += objectCount;
+
+    if (objectCount == 0)
+    {
+        return;
+    }
+
+    const FrameResources& frame = frames[currentFrame];
+
+    //every indirect pipeline shares the layout, so the set and the camera survive the pipeline binds below
+    const VkDescriptorSet drawSets[] = { frame.descriptorSet, cameraSet };
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, drawPipelineLayout, 0, 2, drawSets, 0, nullptr);
+
+    constexpr uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
+
+    VkPipeline boundPipeline = VK_NULL_HANDLE;
+    VkIndexType boundIndexType = VK_INDEX_TYPE_UINT32;
+    for (uint32_t i = 0; i < pipelines.size(); ++i)
+    {
+        const PipelineBatches& pipeline = pipelines[i];
+        const uint32_t batchCount = (uint32_t)pipeline.batches.size();
+        const VkDeviceSize offset = (VkDeviceSize)pipeline.firstCommand * stride;
+
+        //a pipeline drawing meshes of both index types is split in two, bind it once for both
+        if (pipeline.pipeline != boundPipeline)
+        {
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.pipeline);
+            boundPipeline = pipeline.pipeline;
+            ++stats.pipelineBinds;
+        }
+
+        if (pipeline.indexType != boundIndexType)
+        {
+            meshArena.BindIndexBuffer(cmd, pipeline.indexType);
+            boundIndexType = pipeline.indexType;
+        }
+
+        if (drawIndexedIndirectCount != nullptr)
+        {
+            //the GPU decides how many of the pipeline's commands survived culling
+            drawIndexedIndirectCount(cmd, frame.commandBuffer._buffer, offset, frame.countBuffer._buffer, i * sizeof(uint32_t), batchCount, stride);
+            ++stats.drawCalls;
+        }
+        else if (multiDrawIndirect)
+        {
+            //every batch has a command, the fully culled ones draw zero instances
+            vkCmdDrawIndexedIndirect(cmd, frame.commandBuffer._buffer, offset, batchCount, stride);
+            ++stats.drawCalls;
+        }
+        else
+        {
+            for (uint32_t j = 0; j < batchCount; ++j)
+            {
+                vkCmdDrawIndexedIndirect(cmd, frame.commandBuffer._buffer, offset + j * stride, 1, stride);
+            }
+            stats.drawCalls += batchCount;
+        }
+    }
+
+    //whatever is recorded next expects the arena as Bind left it
+    if (boundIndexType != VK_INDEX_TYPE_UINT32)
+    {
+        meshArena.BindIndexBuffer(cmd, VK_INDEX_TYPE_UINT32);
+    }
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+AllocatedBuffer GPUCullingPass::CreateBuffer(const VkDeviceSize size, const VkBufferUsageFlags usage, const bool hostVisible, void** outMapped /* = nullptr*/) const
+{
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.pNext = nullptr;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+
+    VmaAllocationCreateInfo vmaallocInfo = {};
+    vmaallocInfo.usage = hostVisible ? VMA_MEMORY_USAGE_CPU_TO_GPU : VMA_MEMORY_USAGE_GPU_ONLY;
+    vmaallocInfo.flags = hostVisible ? VMA_ALLOCATION_CREATE_MAPPED_BIT : 0;
+
+    AllocatedBuffer buffer;
+    VmaAllocationInfo allocationInfo = {};
+    if (vmaCreateBuffer(allocator, &bufferInfo, &vmaallocInfo, &buffer._buffer, &buffer._allocation, &allocationInfo) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create a GPUCullingPass buffer of " + std::to_string(size) + " bytes.");
+    }
+
+    if (outMapped != nullptr)
+    {
+        *outMapped = allocationInfo.pMappedData;
+    }
+    return buffer;
+}
+
+void GPUCullingPass::DestroyBuffer(AllocatedBuffer& buffer) const
+{
+    if (buffer.IsInitialized())
+    {
+        vmaDestroyBuffer(allocator, buffer._buffer, buffer._allocation);
+        buffer = AllocatedBuffer();
+    }
+}
+
+void GPUCullingPass::ReserveGPUBuffers(FrameResources& frame)
+{
+    const uint32_t batchCount = (uint32_t)batches.size();
+
+    if (batchCount > frame.batchCapacity)
+    {
+        DestroyBuffer(frame.batchBuffer);
+
+        void* mapped = nullptr;
+        frame.batchCapacity = GrowCapacity(frame.batchCapacity, batchCount);
+        frame.batchBuffer = CreateBuffer(frame.batchCapacity * sizeof(DrawBatch), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, true, &mapped);
+        frame.mappedBatches = static_cast<DrawBatch*>(mapped);
+    }
+
+    if (batchCount > frame.commandCapacity)
+    {
+        DestroyBuffer(frame.commandBuffer);
+
+        frame.commandCapacity = GrowCapacity(frame.commandCapacity, batchCount);
+        frame.commandBuffer = CreateBuffer
+        (
+            frame.commandCapacity * sizeof(VkDrawIndexedIndirectCommand),
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+            false
+        );
+    }
+
+    if (objectCount > frame.visibleCapacity)
+    {
+        DestroyBuffer(frame.visibleBuffer);
+
+        frame.visibleCapacity = GrowCapacity(frame.visibleCapacity, objectCount);
+        frame.visibleBuffer = CreateBuffer(frame.visibleCapacity * sizeof(uint32_t), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, false);
+    }
+}
+
+void GPUCullingPass::UpdateDescriptorSet(const FrameResources& frame) const
+{
+    const std::array<VkDescriptorBufferInfo, 5> bufferInfos
+    {
+        VkDescriptorBufferInfo{frame.objectBuffer._buffer, 0, VK_WHOLE_SIZE},
+        VkDescriptorBufferInfo{frame.batchBuffer._buffer, 0, VK_WHOLE_SIZE},
+        VkDescriptorBufferInfo{frame.visibleBuffer._buffer, 0, VK_WHOLE_SIZE},
+        VkDescriptorBufferInfo{frame.commandBuffer._buffer, 0, VK_WHOLE_SIZE},
+        VkDescriptorBufferInfo{frame.countBuffer._buffer, 0, VK_WHOLE_SIZE}
+    };
+
+    std::array<VkWriteDescriptorSet, 5> writes{};
+    for (uint32_t i = 0; i < writes.size(); ++i)
+    {
+        writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].dstSet = frame.descriptorSet;
+        writes[i].dstBinding = i;
+        writes[i].descriptorCount = 1;
+        writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[i].pBufferInfo = &bufferInfos[i];
+    }
+
+    //the set was last used by this frame's previous submission, which has completed
+    vkUpdateDescriptorSets(device, (uint32_t)writes.size(), writes.data(), 0, nullptr);
+}
+
+uint32_t GPUCullingPass::GrowCapacity(const uint32_t current, const uint32_t required)
+{
+    uint32_t capacity = std::max(current * 2, 1024u);
+    while (capacity < required)
+    {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+} // namespace velecs
@@ -0,0 +1,237 @@
+/// @file    GPUProfiler.cpp
+/// @author  Matthew Green
+/// @date    2026-10-18 01:41:26
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/GPUProfiler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <stdexcept>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+GPUProfiler::Scope::Scope(GPUProfiler& profiler, VkCommandBuffer cmd, const char* name)
+    : profiler(profiler), cmd(cmd), scope(profiler.BeginScope(cmd, name)) {}
+
+GPUProfiler::Scope::~Scope()
+{
+    profiler.EndScope(cmd, scope);
+}
+
+// Public Methods
+
+void GPUProfiler::Init(VkDevice device, VkPhysicalDevice physicalDevice, const uint32_t queueFamily, const uint32_t framesInFlight, const uint32_t maxScopes)
+{
+    this->device = device;
+    this->maxScopes = maxScopes;
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    timestampPeriod = properties.limits.timestampPeriod;
+
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount, families.data());
+    timestampValidBits = queueFamily < familyCount ? families[queueFamily].timestampValidBits : 0;
+
+    if (!IsSupported())
+    {
+        return;
+    }
+
+    frames.resize(framesInFlight);
+    for (FrameQueries& frame : frames)
+    {
+        VkQueryPoolCreateInfo poolInfo = {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        poolInfo.pNext = nullptr;
+        poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        poolInfo.queryCount = maxScopes * 2; // a begin and an end timestamp per scope
+
+        if (vkCreateQueryPool(device, &poolInfo, nullptr, &frame.pool) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create the timestamp query pool.");
+        }
+
+        frame.names.resize(maxScopes, nullptr);
+    }
+
+    results.resize(maxScopes * 2);
+}
+
+void GPUProfiler::Cleanup()
+{
+    for (FrameQueries& frame : frames)
+    {
+        if (frame.pool != VK_NULL_HANDLE)
+        {
+            vkDestroyQueryPool(device, frame.pool, nullptr);
+        }
+    }
+    frames.clear();
+    currentFrame = nullptr;
+}
+
+void GPUProfiler::BeginFrame(VkCommandBuffer cmd, const uint32_t frameIndex)
+{
+    if (!IsSupported())
+    {
+        return;
+    }
+
+    //every scope of the previous frame has been recorded by now
+    if (currentFrame != nullptr)
+    {
+        currentFrame->scopeCount = std::min(nextScope.load(std::memory_order_relaxed), maxScopes);
+    }
+
+    FrameQueries& frame = frames[frameIndex];
+
+    //the frame's fence was waited on, its timestamps are already available and reading them does not block
+    if (frame.scopeCount > 0)
+    {
+        ReadResults(frame);
+    }
+
+    vkCmdResetQueryPool(cmd, frame.pool, 0, maxScopes * 2);
+
+    frame.scopeCount = 0;
+    currentFrame = &frame;
+    nextScope.store(0, std::memory_order_relaxed);
+}
+
+uint32_t GPUProfiler::BeginScope(VkCommandBuffer cmd, const char* name)
+{
+    if (currentFrame == nullptr)
+    {
+        return INVALID_SCOPE;
+    }
+
+    const uint32_t scope = nextScope.fetch_add(1, std::memory_order_relaxed);
+    if (scope >= maxScopes)
+    {
+        return INVALID_SCOPE; // out of queries, the scope is not measured this frame
+    }
+
+    currentFrame->names[scope] = name;
+    vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, currentFrame->pool, scope * 2);
+    return scope;
+}
+
+void GPUProfiler::EndScope(VkCommandBuffer cmd, const uint32_t scope)
+{
+    if (scope == INVALID_SCOPE)
+    {
+        return;
+    }
+
+    //bottom of pipe waits for every command recorded before it to complete
+    vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, currentFrame->pool, scope * 2 + 1);
+}
+
+const GPUProfiler::PassTiming* GPUProfiler::FindPassTiming(const std::string& name) const
+{
+    for (const PassTiming& pass : passes)
+    {
+        if (pass.name == name)
+        {
+            return &pass;
+        }
+    }
+    return nullptr;
+}
+
+void GPUProfiler::Log(std::ostream& stream) const
+{
+    stream << "[INFO] GPU timings (average over " << HISTORY_SIZE << " frames):" << std::endl;
+    for (const PassTiming& pass : passes)
+    {
+        stream << "\t" << std::left << std::setw(32) << pass.name << std::right << std::fixed << std::setprecision(3)
+            << pass.averageMs << " ms avg, " << pass.lastMs << " ms last, " << pass.maxMs << " ms max" << std::endl;
+    }
+    stream.unsetf(std::ios::floatfield);
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void GPUProfiler::ReadResults(const FrameQueries& frame)
+{
+    const uint32_t queryCount = frame.scopeCount * 2;
+
+    //no wait flag: if a timestamp is unavailable, or a scope was never ended, the frame is skipped instead of stalling
+    const VkResult result = vkGetQueryPoolResults
+    (
+        device, frame.pool, 0, queryCount,
+        queryCount * sizeof(uint64_t), results.data(), sizeof(uint64_t),
+        VK_QUERY_RESULT_64_BIT
+    );
+    if (result != VK_SUCCESS)
+    {
+        return;
+    }
+
+    const uint64_t mask = timestampValidBits >= 64 ? UINT64_MAX : ((uint64_t)1 << timestampValidBits) - 1;
+
+    std::fill(frameTotals.begin(), frameTotals.end(), 0.0f);
+    for (uint32_t scope = 0; scope < frame.scopeCount; ++scope)
+    {
+        const uint32_t pass = GetPassIndex(frame.names[scope]);
+        const uint64_t ticks = (results[scope * 2 + 1] - results[scope * 2]) & mask;
+        frameTotals[pass] += (float)((double)ticks * timestampPeriod / 1000000.0);
+    }
+
+    for (uint32_t i = 0; i < passes.size(); ++i)
+    {
+        PassTiming& pass = passes[i];
+        pass.lastMs = frameTotals[i];
+
+        pass.history[pass.historyOffset] = pass.lastMs;
+        pass.historyOffset = (pass.historyOffset + 1) % HISTORY_SIZE;
+        pass.historyCount = std::min(pass.historyCount + 1, HISTORY_SIZE);
+
+        float sum = 0.0f;
+        pass.maxMs = 0.0f;
+        for (uint32_t j = 0; j < pass.historyCount; ++j)
+        {
+            sum += pass.history[j];
+            pass.maxMs = std::max(pass.maxMs, pass.history[j]);
+        }
+        pass.averageMs = sum / pass.historyCount;
+    }
+}
+
+uint32_t GPUProfiler::GetPassIndex(const char* name)
+{
+    for (uint32_t i = 0; i < passes.size(); ++i)
+    {
+        if (passes[i].name == name)
+        {
+            return i;
+        }
+    }
+
+    PassTiming pass;
+    pass.name = name;
+    passes.push_back(pass);
+    frameTotals.push_back(0.0f);
+    return (uint32_t)passes.size() - 1;
+}
+
+} // namespace velecs
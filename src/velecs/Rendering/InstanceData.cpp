@@ -0,0 +1,61 @@
+/// @file    InstanceData.cpp
+/// @author  Matthew Green
+/// @date    2026-10-17 19:44:51
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/InstanceData.h"
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void InstanceData::AppendVertexDescription(VertexInputAttributeDescriptor& description)
+{
+    //the instance buffer advances once per instance instead of once per vertex
+    VkVertexInputBindingDescription instanceBinding = {};
+    instanceBinding.binding = BINDING;
+    instanceBinding.stride = sizeof(InstanceData);
+    instanceBinding.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+    description.bindings.push_back(instanceBinding);
+
+    //a mat4 attribute takes up 4 consecutive locations, one per column
+    for (uint32_t column = 0; column < 4; ++column)
+    {
+        VkVertexInputAttributeDescription matrixAttribute = {};
+        matrixAttribute.binding = BINDING;
+        matrixAttribute.location = FIRST_LOCATION + column;
+        matrixAttribute.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+        matrixAttribute.offset = offsetof(InstanceData, modelMatrix) + column * sizeof(glm::vec4);
+
+        description.attributes.push_back(matrixAttribute);
+    }
+
+    //Color will be stored right after the matrix columns
+    VkVertexInputAttributeDescription colorAttribute = {};
+    colorAttribute.binding = BINDING;
+    colorAttribute.location = FIRST_LOCATION + 4;
+    colorAttribute.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+    colorAttribute.offset = offsetof(InstanceData, color);
+
+    description.attributes.push_back(colorAttribute);
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
@@ -0,0 +1,157 @@
+/// @file    MeshArena.cpp
+/// @author  Matthew Green
+/// @date    2026-10-17 20:47:32
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/MeshArena.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void MeshArena::Init
+(
+    VmaAllocator allocator,
+    const uint32_t vertexStride,
+    const uint32_t vertexCapacity,
+    const uint32_t indexCapacity,
+    const std::vector<uint32_t>& queueFamilies
+)
+{
+    this->allocator = allocator;
+    this->vertexStride = vertexStride;
+
+    vertexBuffer = CreateBuffer((VkDeviceSize)vertexCapacity * vertexStride, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, queueFamilies);
+    indexBuffer = CreateBuffer((VkDeviceSize)indexCapacity * sizeof(uint32_t), VK_BUFFER_USAGE_INDEX_BUFFER_BIT, queueFamilies);
+
+    vertexRanges = RangeAllocator(vertexCapacity);
+    indexRanges = RangeAllocator(indexCapacity * 2);
+}
+
+void MeshArena::Cleanup()
+{
+    if (vertexBuffer.IsInitialized())
+    {
+        vmaDestroyBuffer(allocator, vertexBuffer._buffer, vertexBuffer._allocation);
+        vertexBuffer = AllocatedBuffer();
+    }
+
+    if (indexBuffer.IsInitialized())
+    {
+        vmaDestroyBuffer(allocator, indexBuffer._buffer, indexBuffer._allocation);
+        indexBuffer = AllocatedBuffer();
+    }
+
+    vertexRanges = RangeAllocator();
+    indexRanges = RangeAllocator();
+}
+
+bool MeshArena::TryAllocate(const uint32_t vertexCount, const uint32_t indexCount, const VkIndexType indexType, MeshRange& outRange)
+{
+    uint32_t vertexOffset = 0;
+    if (!vertexRanges.TryAllocate(vertexCount, vertexOffset))
+    {
+        return false;
+    }
+
+    //ranges are counted in 16-bit units, a 32-bit mesh takes two per index
+    uint32_t firstUnit = 0;
+    if (!indexRanges.TryAllocate(GetIndexUnits(indexCount, indexType), firstUnit))
+    {
+        vertexRanges.Free(vertexOffset, vertexCount);
+        return false;
+    }
+
+    outRange.firstIndex = firstUnit * 2 / GetIndexSize(indexType);
+    outRange.indexCount = indexCount;
+    outRange.vertexOffset = (int32_t)vertexOffset;
+    outRange.vertexCount = vertexCount;
+    outRange.indexType = indexType;
+    return true;
+}
+
+void MeshArena::Free(const MeshRange& range)
+{
+    if (!range.IsValid())
+    {
+        return;
+    }
+
+    vertexRanges.Free((uint32_t)range.vertexOffset, range.vertexCount);
+    indexRanges.Free(range.firstIndex * GetIndexSize(range.indexType) / 2, GetIndexUnits(range.indexCount, range.indexType));
+}
+
+void MeshArena::Bind(VkCommandBuffer cmd) const
+{
+    VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(cmd, 0, 1, &vertexBuffer._buffer, &offset);
+
+    vkCmdBindIndexBuffer(cmd, indexBuffer._buffer, 0, VK_INDEX_TYPE_UINT32);
+}
+
+void MeshArena::BindIndexBuffer(VkCommandBuffer cmd, const VkIndexType indexType) const
+{
+    vkCmdBindIndexBuffer(cmd, indexBuffer._buffer, 0, indexType);
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+uint32_t MeshArena::GetIndexUnits(const uint32_t indexCount, const VkIndexType indexType)
+{
+    //rounding every range up to an even size keeps every free range, and so every offset, even
+    const uint32_t units = indexCount * GetIndexSize(indexType) / 2;
+    return units + (units & 1);
+}
+
+AllocatedBuffer MeshArena::CreateBuffer(const VkDeviceSize size, const VkBufferUsageFlags usage, const std::vector<uint32_t>& queueFamilies) const
+{
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.pNext = nullptr;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    //uploads may be written by a dedicated transfer queue while the graphics queue reads other ranges,
+    //concurrent sharing avoids having to transfer queue family ownership for every upload
+    if (queueFamilies.size() > 1)
+    {
+        bufferInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        bufferInfo.queueFamilyIndexCount = (uint32_t)queueFamilies.size();
+        bufferInfo.pQueueFamilyIndices = queueFamilies.data();
+    }
+    else
+    {
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    }
+
+    //let the VMA library know that this data should be GPU native
+    VmaAllocationCreateInfo vmaallocInfo = {};
+    vmaallocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+
+    AllocatedBuffer buffer;
+    if (vmaCreateBuffer(allocator, &bufferInfo, &vmaallocInfo, &buffer._buffer, &buffer._allocation, nullptr) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create a MeshArena buffer of " + std::to_string(size) + " bytes.");
+    }
+    return buffer;
+}
+
+} // namespace velecs
@@ -0,0 +1,354 @@
+/// @file    MeshSimplifier.cpp
+/// @author  Matthew Green
+/// @date    2026-10-18 04:20:51
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/MeshSimplifier.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+MeshSimplifier::MeshSimplifier(const std::vector<SimpleVertex>& vertices, const std::vector<uint32_t>& indices)
+{
+    const uint32_t vertexCount = (uint32_t)vertices.size();
+
+    //imported meshes split vertices along seams, the collapses have to see through them
+    std::map<std::array<float, 3>, uint32_t> welded;
+    remap.resize(vertexCount);
+    positions.resize(vertexCount);
+    for (uint32_t i = 0; i < vertexCount; ++i)
+    {
+        const glm::vec3& position = vertices[i].position;
+        remap[i] = welded.try_emplace({position.x, position.y, position.z}, i).first->second;
+        positions[i] = glm::dvec3(position);
+    }
+
+    quadrics.resize(vertexCount);
+    versions.assign(vertexCount, 0);
+    removed.assign(vertexCount, false);
+    vertexTriangles.resize(vertexCount);
+
+    triangles.reserve(indices.size() / 3);
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        const std::array<uint32_t, 3> triangle = { remap[indices[i]], remap[indices[i + 1]], remap[indices[i + 2]] };
+        if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[2] == triangle[0])
+        {
+            continue; // degenerate once welded
+        }
+
+        const uint32_t triangleIndex = (uint32_t)triangles.size();
+        triangles.push_back(triangle);
+        for (const uint32_t vertex : triangle)
+        {
+            vertexTriangles[vertex].push_back(triangleIndex);
+        }
+    }
+    deadTriangles.assign(triangles.size(), false);
+    liveTriangles = (uint32_t)triangles.size();
+
+    //edges used by a single triangle are open borders
+    std::map<std::pair<uint32_t, uint32_t>, uint32_t> edgeUses;
+    for (const std::array<uint32_t, 3>& triangle : triangles)
+    {
+        for (uint32_t corner = 0; corner < 3; ++corner)
+        {
+            const uint32_t a = triangle[corner];
+            const uint32_t b = triangle[(corner + 1) % 3];
+            ++edgeUses[std::minmax(a, b)];
+        }
+    }
+
+    for (const std::array<uint32_t, 3>& triangle : triangles)
+    {
+        const glm::dvec3 normal = GetNormal(triangle, triangle[0], triangle[0]);
+        const double length = glm::length(normal);
+        if (length == 0.0)
+        {
+            continue;
+        }
+
+        //unweighted planes keep the cost a sum of squared distances, its root bounds the deviation
+        const glm::dvec3 unitNormal = normal / length;
+        Quadric plane;
+        plane.AddPlane(unitNormal, -glm::dot(unitNormal, positions[triangle[0]]), 1.0);
+        for (const uint32_t vertex : triangle)
+        {
+            quadrics[vertex].Add(plane);
+        }
+
+        for (uint32_t corner = 0; corner < 3; ++corner)
+        {
+            const uint32_t a = triangle[corner];
+            const uint32_t b = triangle[(corner + 1) % 3];
+            if (edgeUses[std::minmax(a, b)] != 1)
+            {
+                continue;
+            }
+
+            //a plane through the border, perpendicular to the triangle, keeps the border from sliding
+            const glm::dvec3 borderNormal = glm::cross(positions[b] - positions[a], unitNormal);
+            const double borderLength = glm::length(borderNormal);
+            if (borderLength == 0.0)
+            {
+                continue;
+            }
+
+            const glm::dvec3 unitBorderNormal = borderNormal / borderLength;
+            Quadric border;
+            border.AddPlane(unitBorderNormal, -glm::dot(unitBorderNormal, positions[a]), BOUNDARY_WEIGHT);
+            quadrics[a].Add(border);
+            quadrics[b].Add(border);
+        }
+    }
+
+    for (const auto& [edge, uses] : edgeUses)
+    {
+        PushEdge(edge.first, edge.second);
+    }
+}
+
+// Public Methods
+
+uint32_t MeshSimplifier::Simplify(const uint32_t targetIndexCount)
+{
+    while (GetIndexCount() > targetIndexCount && !candidates.empty())
+    {
+        const Collapse collapse = candidates.top();
+        candidates.pop();
+
+        //the neighborhood changed since the candidate was computed, a fresh one was pushed then
+        if (removed[collapse.from] || removed[collapse.to] ||
+            versions[collapse.from] != collapse.fromVersion || versions[collapse.to] != collapse.toVersion)
+        {
+            continue;
+        }
+
+        if (!CanCollapse(collapse.from, collapse.to))
+        {
+            continue;
+        }
+
+        ApplyCollapse(collapse.from, collapse.to);
+        error = std::max(error, (float)std::sqrt(collapse.cost));
+    }
+
+    return GetIndexCount();
+}
+
+void MeshSimplifier::AppendIndices(std::vector<uint32_t>& indices) const
+{
+    indices.reserve(indices.size() + GetIndexCount());
+    for (size_t i = 0; i < triangles.size(); ++i)
+    {
+        if (!deadTriangles[i])
+        {
+            indices.insert(indices.end(), triangles[i].begin(), triangles[i].end());
+        }
+    }
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+void MeshSimplifier::Quadric::AddPlane(const glm::dvec3& normal, const double d, const double weight)
+{
+    a2 += weight * normal.x * normal.x;
+    ab += weight * normal.x * normal.y;
+    ac += weight * normal.x * normal.z;
+    ad += weight * normal.x * d;
+    b2 += weight * normal.y * normal.y;
+    bc += weight * normal.y * normal.z;
+    bd += weight * normal.y * d;
+    c2 += weight * normal.z * normal.z;
+    cd += weight * normal.z * d;
+    d2 += weight * d * d;
+}
+
+void MeshSimplifier::Quadric::Add(const Quadric& other)
+{
+    a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+    b2 += other.b2; bc += other.bc; bd += other.bd;
+    c2 += other.c2; cd += other.cd;
+    d2 += other.d2;
+}
+
+double MeshSimplifier::Quadric::Evaluate(const glm::dvec3& point) const
+{
+    const double x = point.x;
+    const double y = point.y;
+    const double z = point.z;
+
+    const double value = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x
+        + b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y
+        + c2 * z * z + 2.0 * cd * z
+        + d2;
+
+    return std::max(value, 0.0); // rounding can dip below 0 for points on every plane
+}
+
+void MeshSimplifier::PushEdge(const uint32_t a, const uint32_t b)
+{
+    Quadric merged = quadrics[a];
+    merged.Add(quadrics[b]);
+
+    const double costToA = merged.Evaluate(positions[a]);
+    const double costToB = merged.Evaluate(positions[b]);
+
+    Collapse collapse = {};
+    collapse.cost = std::min(costToA, costToB);
+    collapse.from = costToA < costToB ? b : a;
+    collapse.to = costToA < costToB ? a : b;
+    collapse.fromVersion = versions[collapse.from];
+    collapse.toVersion = versions[collapse.to];
+    candidates.push(collapse);
+}
+
+bool MeshSimplifier::CanCollapse(const uint32_t from, const uint32_t to)
+{
+    //more shared neighbors than shared triangles would pinch the surface into a non-manifold edge
+    GatherNeighbors(from, neighborScratch);
+    GatherNeighbors(to, otherNeighborScratch);
+
+    uint32_t sharedNeighbors = 0;
+    auto other = otherNeighborScratch.begin();
+    for (const uint32_t neighbor : neighborScratch)
+    {
+        while (other != otherNeighborScratch.end() && *other < neighbor)
+        {
+            ++other;
+        }
+        if (other != otherNeighborScratch.end() && *other == neighbor)
+        {
+            ++sharedNeighbors;
+        }
+    }
+
+    uint32_t sharedTriangles = 0;
+    for (const uint32_t triangleIndex : vertexTriangles[from])
+    {
+        if (deadTriangles[triangleIndex])
+        {
+            continue;
+        }
+
+        const std::array<uint32_t, 3>& triangle = triangles[triangleIndex];
+        if (std::find(triangle.begin(), triangle.end(), to) != triangle.end())
+        {
+            ++sharedTriangles;
+            continue; // removed by the collapse
+        }
+
+        const glm::dvec3 before = GetNormal(triangle, from, from);
+        const glm::dvec3 after = GetNormal(triangle, from, to);
+        const double afterLengthSquared = glm::dot(after, after);
+        if (afterLengthSquared == 0.0)
+        {
+            return false; // would become degenerate
+        }
+
+        const double cosine = glm::dot(before, after) / std::sqrt(glm::dot(before, before) * afterLengthSquared);
+        if (cosine < MIN_NORMAL_DOT)
+        {
+            return false; // would flip or fold over
+        }
+    }
+
+    return sharedTriangles != 0 && sharedNeighbors <= sharedTriangles;
+}
+
+void MeshSimplifier::ApplyCollapse(const uint32_t from, const uint32_t to)
+{
+    for (const uint32_t triangleIndex : vertexTriangles[from])
+    {
+        if (deadTriangles[triangleIndex])
+        {
+            continue;
+        }
+
+        std::array<uint32_t, 3>& triangle = triangles[triangleIndex];
+        if (std::find(triangle.begin(), triangle.end(), to) != triangle.end())
+        {
+            deadTriangles[triangleIndex] = true;
+            --liveTriangles;
+            continue;
+        }
+
+        std::replace(triangle.begin(), triangle.end(), from, to);
+        vertexTriangles[to].push_back(triangleIndex);
+    }
+
+    vertexTriangles[from].clear();
+    vertexTriangles[from].shrink_to_fit();
+    removed[from] = true;
+
+    //drop the dead triangles, the list would otherwise keep growing around busy vertices
+    std::vector<uint32_t>& toTriangles = vertexTriangles[to];
+    toTriangles.erase
+    (
+        std::remove_if(toTriangles.begin(), toTriangles.end(), [this](const uint32_t triangleIndex) { return deadTriangles[triangleIndex]; }),
+        toTriangles.end()
+    );
+
+    quadrics[to].Add(quadrics[from]);
+    ++versions[to];
+
+    GatherNeighbors(to, neighborScratch);
+    for (const uint32_t neighbor : neighborScratch)
+    {
+        PushEdge(to, neighbor);
+    }
+}
+
+void MeshSimplifier::GatherNeighbors(const uint32_t vertex, std::vector<uint32_t>& neighbors) const
+{
+    neighbors.clear();
+    for (const uint32_t triangleIndex : vertexTriangles[vertex])
+    {
+        if (deadTriangles[triangleIndex])
+        {
+            continue;
+        }
+
+        for (const uint32_t corner : triangles[triangleIndex])
+        {
+            if (corner != vertex)
+            {
+                neighbors.push_back(corner);
+            }
+        }
+    }
+
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+}
+
+glm::dvec3 MeshSimplifier::GetNormal(const std::array<uint32_t, 3>& triangle, const uint32_t from, const uint32_t to) const
+{
+    const glm::dvec3& p0 = positions[triangle[0] == from ? to : triangle[0]];
+    const glm::dvec3& p1 = positions[triangle[1] == from ? to : triangle[1]];
+    const glm::dvec3& p2 = positions[triangle[2] == from ? to : triangle[2]];
+    return glm::cross(p1 - p0, p2 - p0);
+}
+
+} // namespace velecs
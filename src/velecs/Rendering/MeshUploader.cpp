@@ -0,0 +1,333 @@
+/// @file    MeshUploader.cpp
+/// @author  Matthew Green
+/// @date    2026-10-17 21:20:44
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/MeshUploader.h"
+
+#include "velecs/Rendering/MeshArena.h"
+#include "velecs/Rendering/QuantizedSimpleVertex.h"
+#include "velecs/ECS/Components/Rendering/SimpleMesh.h"
+#include "velecs/Engine/vk_initializers.h"
+
+#include <glm/glm.hpp>
+
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void MeshUploader::Init
+(
+    VkDevice device,
+    VmaAllocator allocator,
+    VkQueue queue,
+    const uint32_t queueFamily,
+    MeshArena* const arena,
+    const VkDeviceSize stagingSize,
+    const bool quantizePositions
+)
+{
+    this->device = device;
+    this->allocator = allocator;
+    this->queue = queue;
+    this->arena = arena;
+    this->stagingSize = stagingSize;
+    this->quantizePositions = quantizePositions;
+
+    //batches are recycled individually, so their command buffers must be resettable on their own
+    VkCommandPoolCreateInfo commandPoolInfo = vkinit::command_pool_create_info(queueFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+    if (vkCreateCommandPool(device, &commandPoolInfo, nullptr, &commandPool) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the MeshUploader command pool.");
+    }
+
+    VkBufferCreateInfo bufferInfo = {};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.pNext = nullptr;
+    bufferInfo.size = stagingSize;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+    //written by the CPU and only ever copied from, keep it persistently mapped
+    VmaAllocationCreateInfo vmaallocInfo = {};
+    vmaallocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+    vmaallocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    VmaAllocationInfo allocationInfo = {};
+    if (vmaCreateBuffer(allocator, &bufferInfo, &vmaallocInfo, &stagingBuffer._buffer, &stagingBuffer._allocation, &allocationInfo) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to create the MeshUploader staging ring of " + std::to_string(stagingSize) + " bytes.");
+    }
+    stagingMapped = static_cast<char*>(allocationInfo.pMappedData);
+}
+
+void MeshUploader::Cleanup()
+{
+    for (const UploadBatch& batch : inFlightBatches)
+    {
+        vkWaitForFences(device, 1, &batch.fence, true, UINT64_MAX);
+    }
+
+    if (isRecording)
+    {
+        vkEndCommandBuffer(recordingBatch.commandBuffer);
+        freeBatches.push_back(recordingBatch);
+        isRecording = false;
+    }
+
+    while (!inFlightBatches.empty())
+    {
+        freeBatches.push_back(inFlightBatches.front());
+        inFlightBatches.pop_front();
+    }
+
+    for (const UploadBatch& batch : freeBatches)
+    {
+        vkDestroyFence(device, batch.fence, nullptr);
+    }
+    freeBatches.clear();
+
+    //destroying the pool frees every command buffer allocated from it
+    vkDestroyCommandPool(device, commandPool, nullptr);
+    commandPool = VK_NULL_HANDLE;
+
+    vmaDestroyBuffer(allocator, stagingBuffer._buffer, stagingBuffer._allocation);
+    stagingBuffer = AllocatedBuffer();
+    stagingMapped = nullptr;
+}
+
+bool MeshUploader::TryEnqueue(SimpleMesh& mesh)
+{
+    //the arena has no empty ranges, failing here would be mistaken for it being full and retried every frame
+    if (mesh._vertices.empty() || mesh._indices.empty())
+    {
+        throw std::runtime_error("Mesh of " + std::to_string(mesh._vertices.size()) + " vertices and " +
+            std::to_string(mesh._indices.size()) + " indices has nothing to upload.");
+    }
+
+    //16 bits reach every vertex of most meshes, halving their index data
+    const VkIndexType indexType = mesh._vertices.size() <= 65536 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+
+    const VkDeviceSize vertexSize = quantizePositions ? sizeof(QuantizedSimpleVertex) : sizeof(SimpleVertex);
+    const VkDeviceSize verticesSize = mesh._vertices.size() * vertexSize;
+    const VkDeviceSize indicesSize = mesh._indices.size() * MeshArena::GetIndexSize(indexType);
+    const VkDeviceSize uploadSize = verticesSize + indicesSize;
+
+    if (uploadSize > stagingSize)
+    {
+        throw std::runtime_error("Mesh of " + std::to_string(uploadSize) + " bytes can never fit into the " +
+            std::to_string(stagingSize) + " byte staging ring.");
+    }
+
+    //the arena range comes first, reserving staging space moves the ring head which a failure would leave behind
+    MeshRange range;
+    if (!arena->TryAllocate((uint32_t)mesh._vertices.size(), (uint32_t)mesh._indices.size(), indexType, range))
+    {
+        //called from the draw systems, the mesh is skipped and tried again next frame once removed meshes freed their ranges
+        if (!arenaFull)
+        {
+            std::cout << "[WARNING] [MeshUploader] The MeshArena has no room for a mesh of " << mesh._vertices.size() << " vertices and "
+                << mesh._indices.size() << " indices, it is not drawn until enough meshes are removed." << std::endl;
+            arenaFull = true;
+        }
+        return false;
+    }
+    arenaFull = false;
+
+    VkDeviceSize stagingOffset = 0;
+    if (!TryAllocateStaging(uploadSize, stagingOffset))
+    {
+        arena->Free(range);
+        return false; // ring is full until older batches retire, try again next frame
+    }
+
+    char* const stagingVertices = stagingMapped + stagingOffset;
+    if (quantizePositions)
+    {
+        //measured here rather than read from _bounds, which meshes built by hand may never have computed
+        glm::vec3 min = mesh._vertices[0].position;
+        glm::vec3 max = mesh._vertices[0].position;
+        for (const SimpleVertex& vertex : mesh._vertices)
+        {
+            min = glm::min(min, vertex.position);
+            max = glm::max(max, vertex.position);
+        }
+
+        mesh._positionDequantization = QuantizedSimpleVertex::ComputeDequantization(AABB(min, max));
+        for (size_t i = 0; i < mesh._vertices.size(); ++i)
+        {
+            const QuantizedSimpleVertex vertex = QuantizedSimpleVertex::Quantize(mesh._vertices[i].position, mesh._positionDequantization);
+            memcpy(stagingVertices + i * sizeof(QuantizedSimpleVertex), &vertex, sizeof(QuantizedSimpleVertex));
+        }
+    }
+    else
+    {
+        memcpy(stagingVertices, mesh._vertices.data(), verticesSize);
+    }
+
+    char* const stagingIndices = stagingVertices + verticesSize;
+    if (indexType == VK_INDEX_TYPE_UINT16)
+    {
+        for (size_t i = 0; i < mesh._indices.size(); ++i)
+        {
+            const uint16_t index = (uint16_t)mesh._indices[i];
+            memcpy(stagingIndices + i * sizeof(uint16_t), &index, sizeof(uint16_t));
+        }
+    }
+    else
+    {
+        memcpy(stagingIndices, mesh._indices.data(), indicesSize);
+    }
+
+    BeginBatch();
+
+    VkBufferCopy vertexCopy;
+    vertexCopy.srcOffset = stagingOffset;
+    vertexCopy.dstOffset = arena->GetVertexByteOffset(range);
+    vertexCopy.size = verticesSize;
+    vkCmdCopyBuffer(recordingBatch.commandBuffer, stagingBuffer._buffer, arena->GetVertexBuffer(), 1, &vertexCopy);
+
+    VkBufferCopy indexCopy;
+    indexCopy.srcOffset = stagingOffset + verticesSize;
+    indexCopy.dstOffset = arena->GetIndexByteOffset(range);
+    indexCopy.size = indicesSize;
+    vkCmdCopyBuffer(recordingBatch.commandBuffer, stagingBuffer._buffer, arena->GetIndexBuffer(), 1, &indexCopy);
+
+    recordingBatch.ringEnd = ringHead;
+
+    mesh._range = range;
+    mesh._uploadTicket = recordingBatch.ticket;
+    return true;
+}
+
+void MeshUploader::Submit()
+{
+    if (!isRecording)
+    {
+        return;
+    }
+
+    if (vkEndCommandBuffer(recordingBatch.commandBuffer) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to end a MeshUploader command buffer.");
+    }
+
+    //the ring may not be host coherent depending on the memory type the allocator picked
+    vmaFlushAllocation(allocator, stagingBuffer._allocation, 0, VK_WHOLE_SIZE);
+
+    VkSubmitInfo submit = vkinit::submit_info(&recordingBatch.commandBuffer);
+    if (vkQueueSubmit(queue, 1, &submit, recordingBatch.fence) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to submit a MeshUploader batch.");
+    }
+
+    inFlightBatches.push_back(recordingBatch);
+    isRecording = false;
+}
+
+void MeshUploader::Poll()
+{
+    //retire in submission order so completedTicket never skips over a pending batch
+    while (!inFlightBatches.empty())
+    {
+        UploadBatch& batch = inFlightBatches.front();
+        if (vkGetFenceStatus(device, batch.fence) != VK_SUCCESS)
+        {
+            break;
+        }
+
+        vkResetFences(device, 1, &batch.fence);
+
+        completedTicket = batch.ticket;
+        ringTail = batch.ringEnd;
+
+        freeBatches.push_back(batch);
+        inFlightBatches.pop_front();
+    }
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+bool MeshUploader::TryAllocateStaging(const VkDeviceSize size, VkDeviceSize& outOffset)
+{
+    //keep every upload 16 byte aligned, which covers both vertex and index data
+    const VkDeviceSize alignedSize = (size + 15) & ~VkDeviceSize(15);
+
+    VkDeviceSize offset = ringHead % stagingSize;
+    VkDeviceSize padding = 0;
+    if (offset + alignedSize > stagingSize)
+    {
+        //the upload doesn't fit before the end of the ring, skip the remainder and wrap around
+        padding = stagingSize - offset;
+        offset = 0;
+    }
+
+    if (ringHead + padding + alignedSize - ringTail > stagingSize)
+    {
+        return false;
+    }
+
+    ringHead += padding + alignedSize;
+    outOffset = offset;
+    return true;
+}
+
+void MeshUploader::BeginBatch()
+{
+    if (isRecording)
+    {
+        return;
+    }
+
+    if (!freeBatches.empty())
+    {
+        recordingBatch = freeBatches.back();
+        freeBatches.pop_back();
+
+        vkResetCommandBuffer(recordingBatch.commandBuffer, 0);
+    }
+    else
+    {
+        recordingBatch = UploadBatch();
+
+        VkCommandBufferAllocateInfo cmdAllocInfo = vkinit::command_buffer_allocate_info(commandPool, 1);
+        VkFenceCreateInfo fenceCreateInfo = vkinit::fence_create_info();
+        if (vkAllocateCommandBuffers(device, &cmdAllocInfo, &recordingBatch.commandBuffer) != VK_SUCCESS ||
+            vkCreateFence(device, &fenceCreateInfo, nullptr, &recordingBatch.fence) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create a MeshUploader batch.");
+        }
+    }
+
+    recordingBatch.ticket = nextTicket++;
+    recordingBatch.ringEnd = ringHead;
+
+    VkCommandBufferBeginInfo cmdBeginInfo = vkinit::command_buffer_begin_info(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+    if (vkBeginCommandBuffer(recordingBatch.commandBuffer, &cmdBeginInfo) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Failed to begin a MeshUploader command buffer.");
+    }
+
+    isRecording = true;
+}
+
+} // namespace velecs
@@ -20,37 +20,52 @@ namespace velecs {
 
 // Public Methods
 
-VkPipeline PipelineBuilder::BuildPipeline(VkDevice device, VkRenderPass pass)
+VkPipeline PipelineBuilder::BuildPipeline(VkDevice device, VkRenderPass pass, VkPipelineCache cache)
+{
+    VkGraphicsPipelineCreateInfo pipelineInfo = GetCreateInfo(pass);
+
+    //it's easy to error out on create graphics pipeline, so we handle it a bit better than the common VK_CHECK case
+    VkPipeline newPipeline;
+    if (vkCreateGraphicsPipelines(device, cache, 1, &pipelineInfo, nullptr, &newPipeline) != VK_SUCCESS)
+    {
+        std::cout << "failed to create pipeline\n";
+        return VK_NULL_HANDLE; // failed to create graphics pipeline
+    }
+    else
+    {
+        return newPipeline;
+    }
+}
+
+VkGraphicsPipelineCreateInfo PipelineBuilder::GetCreateInfo(VkRenderPass pass)
 {
     //make viewport state from our stored viewport and scissor.
     //at the moment we won't support multiple viewports or scissors
-    VkPipelineViewportStateCreateInfo viewportState = {};
-    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-    viewportState.pNext = nullptr;
-    viewportState.viewportCount = 1;
-    viewportState.scissorCount = 1;
+    _viewportState = {};
+    _viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    _viewportState.pNext = nullptr;
+    _viewportState.viewportCount = 1;
+    _viewportState.scissorCount = 1;
 
     // Include dynamic state info in pipeline creation
-    VkDynamicState dynamicStates[] = {
-        VK_DYNAMIC_STATE_VIEWPORT,
-        VK_DYNAMIC_STATE_SCISSOR
-    };
+    _dynamicStates[0] = VK_DYNAMIC_STATE_VIEWPORT;
+    _dynamicStates[1] = VK_DYNAMIC_STATE_SCISSOR;
 
-    VkPipelineDynamicStateCreateInfo dynamicStateInfo = {};
-    dynamicStateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-    dynamicStateInfo.dynamicStateCount = 2; // Number of dynamic states
-    dynamicStateInfo.pDynamicStates = dynamicStates;
+    _dynamicStateInfo = {};
+    _dynamicStateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    _dynamicStateInfo.dynamicStateCount = 2; // Number of dynamic states
+    _dynamicStateInfo.pDynamicStates = _dynamicStates;
 
     //setup dummy color blending. We aren't using transparent objects yet
     //the blending is just "no blend", but we do write to the color attachment
-    VkPipelineColorBlendStateCreateInfo colorBlending = {};
-    colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-    colorBlending.pNext = nullptr;
+    _colorBlending = {};
+    _colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    _colorBlending.pNext = nullptr;
 
-    colorBlending.logicOpEnable = VK_FALSE;
-    colorBlending.logicOp = VK_LOGIC_OP_COPY;
-    colorBlending.attachmentCount = 1;
-    colorBlending.pAttachments = &_colorBlendAttachment;
+    _colorBlending.logicOpEnable = VK_FALSE;
+    _colorBlending.logicOp = VK_LOGIC_OP_COPY;
+    _colorBlending.attachmentCount = 1;
+    _colorBlending.pAttachments = &_colorBlendAttachment;
 
 
     //build the actual pipeline
@@ -63,28 +78,18 @@ VkPipeline PipelineBuilder::BuildPipeline(VkDevice device, VkRenderPass pass)
     pipelineInfo.pStages = _shaderStages.data();
     pipelineInfo.pVertexInputState = &_vertexInputInfo;
     pipelineInfo.pInputAssemblyState = &_inputAssembly;
-    pipelineInfo.pViewportState = &viewportState;
-    pipelineInfo.pDynamicState = &dynamicStateInfo;
+    pipelineInfo.pViewportState = &_viewportState;
+    pipelineInfo.pDynamicState = &_dynamicStateInfo;
     pipelineInfo.pRasterizationState = &_rasterizer;
     pipelineInfo.pMultisampleState = &_multisampling;
-    pipelineInfo.pColorBlendState = &colorBlending;
+    pipelineInfo.pColorBlendState = &_colorBlending;
     pipelineInfo.pDepthStencilState = &_depthStencil;
     pipelineInfo.layout = _pipelineLayout;
     pipelineInfo.renderPass = pass;
     pipelineInfo.subpass = 0;
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
 
-    //it's easy to error out on create graphics pipeline, so we handle it a bit better than the common VK_CHECK case
-    VkPipeline newPipeline;
-    if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &newPipeline) != VK_SUCCESS)
-    {
-        std::cout << "failed to create pipeline\n";
-        return VK_NULL_HANDLE; // failed to create graphics pipeline
-    }
-    else
-    {
-        return newPipeline;
-    }
+    return pipelineInfo;
 }
 
 // Protected Fields
@@ -0,0 +1,155 @@
+/// @file    PipelineCache.cpp
+/// @author  Matthew Green
+/// @date    2026-10-18 00:12:37
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/PipelineCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void PipelineCache::Init(VkDevice device, VkPhysicalDevice physicalDevice, const std::string& filePath)
+{
+    this->device = device;
+    this->filePath = filePath;
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    std::vector<uint8_t> data;
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if (file.is_open())
+    {
+        data.resize((size_t)file.tellg());
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(data.data()), data.size());
+        if (!file)
+        {
+            data.clear();
+        }
+    }
+
+    if (!data.empty() && !IsCompatible(data, properties))
+    {
+        std::cout << "[INFO] Ignoring pipeline cache '" << filePath << "', it was written by another driver or device." << std::endl;
+        data.clear();
+    }
+
+    VkPipelineCacheCreateInfo cacheInfo = {};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cacheInfo.pNext = nullptr;
+    cacheInfo.initialDataSize = data.size();
+    cacheInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+    if (vkCreatePipelineCache(device, &cacheInfo, nullptr, &cache) != VK_SUCCESS)
+    {
+        //the driver may still refuse data that passed the header check, start over cold
+        cacheInfo.initialDataSize = 0;
+        cacheInfo.pInitialData = nullptr;
+        data.clear();
+
+        if (vkCreatePipelineCache(device, &cacheInfo, nullptr, &cache) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create the pipeline cache.");
+        }
+    }
+
+    loadedSize = data.size();
+}
+
+void PipelineCache::Cleanup()
+{
+    if (cache == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    Save();
+
+    vkDestroyPipelineCache(device, cache, nullptr);
+    cache = VK_NULL_HANDLE;
+}
+
+bool PipelineCache::Save() const
+{
+    if (cache == VK_NULL_HANDLE)
+    {
+        return false;
+    }
+
+    size_t size = 0;
+    if (vkGetPipelineCacheData(device, cache, &size, nullptr) != VK_SUCCESS || size == 0)
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> data(size);
+    if (vkGetPipelineCacheData(device, cache, &size, data.data()) != VK_SUCCESS)
+    {
+        return false;
+    }
+
+    //write next to the file and swap it in, a crash mid-write must not leave a truncated cache behind
+    const std::string tempPath = filePath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            std::cout << "[WARNING] Failed to write pipeline cache '" << filePath << "'." << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(data.data()), size);
+        if (!file)
+        {
+            return false;
+        }
+    }
+
+    std::remove(filePath.c_str());
+    return std::rename(tempPath.c_str(), filePath.c_str()) == 0;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+bool PipelineCache::IsCompatible(const std::vector<uint8_t>& data, const VkPhysicalDeviceProperties& properties)
+{
+    //VkPipelineCacheHeaderVersionOne: headerSize, headerVersion, vendorID, deviceID, then the UUID
+    constexpr size_t headerSize = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+    if (data.size() < headerSize)
+    {
+        return false;
+    }
+
+    uint32_t header[4];
+    std::memcpy(header, data.data(), sizeof(header));
+
+    return header[0] >= headerSize
+        && header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+        && header[2] == properties.vendorID
+        && header[3] == properties.deviceID
+        && std::memcmp(data.data() + sizeof(header), properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+} // namespace velecs
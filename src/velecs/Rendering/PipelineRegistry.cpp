@@ -0,0 +1,143 @@
+/// @file    PipelineRegistry.cpp
+/// @author  Matthew Green
+/// @date    2026-10-18 00:48:20
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/PipelineRegistry.h"
+
+#include "velecs/Rendering/ShaderModule.h"
+
+#include "velecs/Core/JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void PipelineRegistry::Add
+(
+    VkPipeline* const outPipeline,
+    const std::string& vertShader,
+    const std::string& fragShader,
+    VkPipelineLayout layout,
+    const VertexInputAttributeDescriptor& vertexInput
+)
+{
+    descriptions.push_back(Description{outPipeline, vertShader, fragShader, layout, vertexInput});
+}
+
+void PipelineRegistry::Build(VkDevice device, VkRenderPass pass, const PipelineBuilder& fixedState, VkPipelineCache cache, JobSystem& jobSystem)
+{
+    if (descriptions.empty())
+    {
+        return;
+    }
+
+    const auto shadersStart = std::chrono::high_resolution_clock::now();
+
+    //pipelines share a lot of shaders, load every distinct one once
+    std::vector<std::pair<std::string, bool>> shaderPaths; // path, true for a vertex shader
+    std::unordered_map<std::string, size_t> shaderIndices;
+    auto findShader = [&](const std::string& path, const bool vertex)
+    {
+        auto [it, inserted] = shaderIndices.emplace(path, shaderPaths.size());
+        if (inserted)
+        {
+            shaderPaths.emplace_back(path, vertex);
+        }
+        return it->second;
+    };
+
+    std::vector<std::pair<size_t, size_t>> pipelineShaders(descriptions.size());
+    for (size_t i = 0; i < descriptions.size(); ++i)
+    {
+        pipelineShaders[i] = {findShader(descriptions[i].vertShader, true), findShader(descriptions[i].fragShader, false)};
+    }
+
+    //ShaderModule destroys its module when destroyed and cannot be moved, construct each one in place
+    std::vector<std::unique_ptr<ShaderModule>> shaders(shaderPaths.size());
+    jobSystem.ParallelFor((uint32_t)shaders.size(), [&](uint32_t i)
+    {
+        const auto& [path, vertex] = shaderPaths[i];
+        shaders[i].reset(vertex
+            ? new ShaderModule(ShaderModule::CreateVertShader(device, path))
+            : new ShaderModule(ShaderModule::CreateFragShader(device, path)));
+    });
+
+    const auto pipelinesStart = std::chrono::high_resolution_clock::now();
+
+    //one builder per pipeline, the create infos point into them
+    std::vector<PipelineBuilder> builders(descriptions.size(), fixedState);
+    std::vector<VkGraphicsPipelineCreateInfo> createInfos(descriptions.size());
+    for (size_t i = 0; i < descriptions.size(); ++i)
+    {
+        const Description& description = descriptions[i];
+        PipelineBuilder& builder = builders[i];
+
+        builder._vertexInputInfo.pVertexAttributeDescriptions = description.vertexInput.attributes.data();
+        builder._vertexInputInfo.vertexAttributeDescriptionCount = (uint32_t)description.vertexInput.attributes.size();
+        builder._vertexInputInfo.pVertexBindingDescriptions = description.vertexInput.bindings.data();
+        builder._vertexInputInfo.vertexBindingDescriptionCount = (uint32_t)description.vertexInput.bindings.size();
+
+        builder._shaderStages.clear();
+        builder._shaderStages.push_back(shaders[pipelineShaders[i].first]->pipelineShaderStageCreateInfo);
+        builder._shaderStages.push_back(shaders[pipelineShaders[i].second]->pipelineShaderStageCreateInfo);
+
+        builder._pipelineLayout = description.layout;
+
+        createInfos[i] = builder.GetCreateInfo(pass);
+    }
+
+    //each thread compiles a contiguous slice in a single call, the cache is internally synchronized
+    std::vector<VkPipeline> pipelines(descriptions.size(), VK_NULL_HANDLE);
+    const uint32_t pipelineCount = (uint32_t)createInfos.size();
+    const uint32_t jobCount = std::min(jobSystem.GetThreadCount(), pipelineCount);
+    jobSystem.ParallelFor(jobCount, [&](uint32_t job)
+    {
+        const uint32_t begin = pipelineCount * job / jobCount;
+        const uint32_t end = pipelineCount * (job + 1) / jobCount;
+
+        if (vkCreateGraphicsPipelines(device, cache, end - begin, createInfos.data() + begin, nullptr, pipelines.data() + begin) != VK_SUCCESS)
+        {
+            std::cout << "failed to create pipeline\n";
+        }
+    });
+
+    for (size_t i = 0; i < descriptions.size(); ++i)
+    {
+        *descriptions[i].outPipeline = pipelines[i];
+    }
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "[INFO] Loaded " << shaders.size() << " shaders in "
+        << std::chrono::duration<float, std::milli>(pipelinesStart - shadersStart).count() << " ms, created "
+        << pipelineCount << " pipelines in "
+        << std::chrono::duration<float, std::milli>(end - pipelinesStart).count() << " ms over "
+        << jobCount << " threads." << std::endl;
+
+    descriptions.clear();
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
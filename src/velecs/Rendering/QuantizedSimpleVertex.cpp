@@ -0,0 +1,83 @@
+/// @file    QuantizedSimpleVertex.cpp
+/// @author  Matthew Green
+/// @date    2026-10-18 05:02:44
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/QuantizedSimpleVertex.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+VertexInputAttributeDescriptor QuantizedSimpleVertex::GetVertexDescription()
+{
+    VertexInputAttributeDescriptor description;
+
+    VkVertexInputBindingDescription mainBinding = {};
+    mainBinding.binding = 0;
+    mainBinding.stride = sizeof(QuantizedSimpleVertex);
+    mainBinding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    description.bindings.push_back(mainBinding);
+
+    //the shaders read a vec3, the unorm format hands them the normalized position as floats
+    VkVertexInputAttributeDescription positionAttribute = {};
+    positionAttribute.binding = 0;
+    positionAttribute.location = 0;
+    positionAttribute.format = VK_FORMAT_R16G16B16A16_UNORM;
+    positionAttribute.offset = offsetof(QuantizedSimpleVertex, position);
+
+    description.attributes.push_back(positionAttribute);
+    return description;
+}
+
+glm::vec4 QuantizedSimpleVertex::ComputeDequantization(const AABB& bounds)
+{
+    //one scale for every axis keeps the dequantization a similarity, bounding spheres stay spheres
+    const glm::vec3 size = bounds.max - bounds.min;
+    const float scale = std::max(std::max(size.x, size.y), size.z);
+    return glm::vec4(bounds.min, scale > 0.0f ? scale : 1.0f);
+}
+
+QuantizedSimpleVertex QuantizedSimpleVertex::Quantize(const glm::vec3& position, const glm::vec4& dequantization)
+{
+    const glm::vec3 normalized = glm::clamp((position - glm::vec3(dequantization)) / dequantization.w, 0.0f, 1.0f);
+
+    QuantizedSimpleVertex vertex;
+    vertex.position[0] = (uint16_t)std::lround(normalized.x * 65535.0f);
+    vertex.position[1] = (uint16_t)std::lround(normalized.y * 65535.0f);
+    vertex.position[2] = (uint16_t)std::lround(normalized.z * 65535.0f);
+    vertex.position[3] = 0;
+    return vertex;
+}
+
+glm::mat4 QuantizedSimpleVertex::GetDequantizationMatrix(const glm::vec4& dequantization)
+{
+    glm::mat4 matrix(dequantization.w);
+    matrix[3] = glm::vec4(glm::vec3(dequantization), 1.0f);
+    return matrix;
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs
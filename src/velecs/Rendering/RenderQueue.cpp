@@ -0,0 +1,132 @@
+/// @file    RenderQueue.cpp
+/// @author  Matthew Green
+/// @date    2026-10-17 22:04:19
+/// 
+/// @section LICENSE
+/// 
+/// Copyright (c) 2023 Matthew Green - All rights reserved
+/// Unauthorized copying of this file, via any medium is strictly prohibited
+/// Proprietary and confidential
+
+#include "velecs/Rendering/RenderQueue.h"
+
+#include "velecs/ECS/Components/Rendering/SimpleMesh.h"
+
+#include <algorithm>
+#include <array>
+
+namespace velecs {
+
+// Public Fields
+
+// Constructors and Destructors
+
+// Public Methods
+
+void RenderQueue::Clear()
+{
+    commands.clear();
+    keys.clear();
+    sortedKeys.clear();
+    sortedIndices.clear();
+
+    pipelineIds.clear();
+    meshIds.clear();
+}
+
+void RenderQueue::Push(const DrawCommand& command, const float depth)
+{
+    //ids are handed out in order of first appearance, they only have to be unique within the frame
+    const uint32_t pipelineId = pipelineIds.try_emplace(command.pipeline, (uint32_t)pipelineIds.size()).first->second;
+    const uint32_t meshId = meshIds.try_emplace(command.mesh, (uint32_t)meshIds.size()).first->second * SimpleMesh::MAX_LODS + command.lod;
+
+    commands.push_back(command);
+    keys.push_back(MakeSortKey(pipelineId, meshId, depth));
+}
+
+void RenderQueue::Sort()
+{
+    const size_t count = keys.size();
+
+    sortedKeys = keys;
+    sortedIndices.resize(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        sortedIndices[i] = i;
+    }
+
+    scratchKeys.resize(count);
+    scratchIndices.resize(count);
+
+    //least significant digit first, one byte per pass
+    for (uint32_t shift = 0; shift < 64; shift += 8)
+    {
+        std::array<uint32_t, 256> histogram{};
+        for (size_t i = 0; i < count; ++i)
+        {
+            ++histogram[(sortedKeys[i] >> shift) & 0xFF];
+        }
+
+        //every key shares this byte, the pass would not move anything
+        if (count == 0 || histogram[(sortedKeys[0] >> shift) & 0xFF] == count)
+        {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (uint32_t& bucket : histogram)
+        {
+            const uint32_t bucketSize = bucket;
+            bucket = offset;
+            offset += bucketSize;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint32_t destination = histogram[(sortedKeys[i] >> shift) & 0xFF]++;
+            scratchKeys[destination] = sortedKeys[i];
+            scratchIndices[destination] = sortedIndices[i];
+        }
+
+        sortedKeys.swap(scratchKeys);
+        sortedIndices.swap(scratchIndices);
+    }
+}
+
+uint32_t RenderQueue::CountUnsortedPipelineChanges() const
+{
+    uint32_t changes = 0;
+    VkPipeline previous = VK_NULL_HANDLE;
+    for (const DrawCommand& command : commands)
+    {
+        if (command.pipeline != previous)
+        {
+            ++changes;
+            previous = command.pipeline;
+        }
+    }
+    return changes;
+}
+
+uint64_t RenderQueue::MakeSortKey(const uint32_t pipelineId, const uint32_t meshId, const float depth)
+{
+    constexpr uint64_t pipelineMask = (1ull << PIPELINE_BITS) - 1;
+    constexpr uint64_t meshMask = (1ull << MESH_BITS) - 1;
+    constexpr uint64_t depthMask = (1ull << DEPTH_BITS) - 1;
+
+    const uint64_t quantizedDepth = (uint64_t)(std::clamp(depth, 0.0f, 1.0f) * (float)depthMask);
+
+    return ((pipelineId & pipelineMask) << (MESH_BITS + DEPTH_BITS)) |
+        ((meshId & meshMask) << DEPTH_BITS) |
+        (quantizedDepth & depthMask);
+}
+
+// Protected Fields
+
+// Protected Methods
+
+// Private Fields
+
+// Private Methods
+
+} // namespace velecs